@@ -17,39 +17,164 @@
 // ============================================================================
 
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
+#include <stdarg.h>
 #include <assert.h>
 #include <math.h>
+
+// Publication de la promotion en mémoire partagée POSIX (shm_open / mmap)
+// et mode batch sur threads POSIX : disponibles sous Linux et macOS. Ailleurs,
+// la promotion reste locale et --batch exécute les commandes séquentiellement.
+#if defined(__unix__) || defined(__APPLE__)
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <sched.h>
+#include <signal.h>
+#include <stdatomic.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#define PROMOTION_PARTAGEE 1
+#define MODE_BATCH 1
+#endif
 #pragma warning(disable:4996 6031 6054)
 
+// Lecture caractère par caractère sans verrou : le flux des commandes n'est
+// lu que par un seul thread (le thread principal, ou le thread de lecture
+// en mode batch), et getc verrouille le flux à chaque appel dès qu'il y a
+// plusieurs threads.
+#ifdef _MSC_VER
+#define LIRE_CARACTERE(flux) _getc_nolock(flux)
+#define REMETTRE_CARACTERE(c, flux) _ungetc_nolock(c, flux)
+#elif defined(MODE_BATCH)
+#define LIRE_CARACTERE(flux) getc_unlocked(flux)
+#define REMETTRE_CARACTERE(c, flux) ungetc(c, flux)
+#else
+#define LIRE_CARACTERE(flux) getc(flux)
+#define REMETTRE_CARACTERE(c, flux) ungetc(c, flux)
+#endif
+
+// Corps génériques toujours développés dans leur appelant : chaque formation en
+// obtient une copie où ses dimensions et ses seuils sont des constantes.
+#if defined(__GNUC__)
+#define SPECIALISE static inline __attribute__((always_inline))
+#elif defined(_MSC_VER)
+#define SPECIALISE static __forceinline
+#else
+#define SPECIALISE static inline
+#endif
+
 // ============================================================================
 // CONSTANTES
 // ============================================================================
 
+/**
+ * @brief Formations disponibles et leurs constantes pédagogiques.
+ *
+ * X(nom, nb_annees, nb_ue, min_rcue_valides, seuil_validation, seuil_bloquant) :
+ * - nb_annees : durée de la formation (deux semestres par année) ;
+ * - nb_ue : nombre d'UE par semestre ;
+ * - min_rcue_valides : nombre minimal d'UE validées pour passer à l'année suivante
+ *   (toutes les UE doivent être validées la dernière année) ;
+ * - seuil_validation : note minimale pour valider une UE (10/20) ;
+ * - seuil_bloquant : note en dessous de laquelle la compensation est impossible.
+ *
+ * Les fonctions de jury et d'affichage de chaque formation sont compilées
+ * avec ces valeurs comme constantes (voir DEFINIR_FORMATION).
+ */
+#define LISTE_FORMATIONS(X) \
+	X(BUT,    3, 6, 4, 10.0f, 8.0f) \
+	X(LP,     1, 4, 3, 10.0f, 8.0f) \
+	X(MASTER, 2, 5, 4, 10.0f, 8.0f)
+
+/**
+ * @brief Dimensions de chaque formation, pour en calculer les maximums.
+ *
+ * Une union de tableaux de la taille de chaque formation a pour taille la
+ * plus grande d'entre elles.
+ */
+#define ANNEES_FORMATION(nom, annees, ...) char nom[annees];
+#define UE_FORMATION(nom, annees, ue, ...) char nom[ue];
+typedef union { LISTE_FORMATIONS(ANNEES_FORMATION) } t_annees_formations;
+typedef union { LISTE_FORMATIONS(UE_FORMATION) } t_ue_formations;
+#undef ANNEES_FORMATION
+#undef UE_FORMATION
+
 /**
  * @brief Limites du système.
+ *
+ * Les tableaux des étudiants sont dimensionnés pour la plus grande des
+ * formations de LISTE_FORMATIONS.
  */
 enum {
-	MAX_ETUDIANTS = 100, /**< Nombre maximum d'étudiants dans la promotion */
-	MAX_NOM = 30,        /**< Longueur maximale d'un nom ou prénom */
-	NB_SEMESTRES = 6,    /**< Nombre total de semestres en BUT */
-	NB_UE = 6,           /**< Nombre d'Unités d'Enseignement par semestre */
-	NB_ANNEES = 3,       /**< Nombre d'années du cursus */
+	MAX_ETUDIANTS = 100,                      /**< Nombre maximum d'étudiants dans la promotion */
+	MAX_NOM = 30,                             /**< Longueur maximale d'un nom ou prénom */
+	MAX_ANNEES = sizeof(t_annees_formations), /**< Nombre maximal d'années d'une formation */
+	MAX_SEMESTRES = 2 * MAX_ANNEES,           /**< Nombre maximal de semestres d'une formation (deux par année) */
+	MAX_UE = sizeof(t_ue_formations),         /**< Nombre maximal d'Unités d'Enseignement par semestre */
 };
 
 /**
- * @brief Seuils de validation et constantes pédagogiques.
+ * @brief Numéros des formations (FORMATION_BUT, FORMATION_LP...).
  */
+#define NUMERO_FORMATION(nom, ...) FORMATION_##nom,
 enum {
-	MIN_RCUE_VALIDES = 4,    /**< Nombre minimal d'UE validées (>10) pour valider une année */
-	TOUTES_UE_VALIDEES = 6,  /**< Nombre d'UE à valider pour certaines conditions (diplôme) */
+	LISTE_FORMATIONS(NUMERO_FORMATION)
+	NB_FORMATIONS, /**< Nombre de formations disponibles */
 };
+#undef NUMERO_FORMATION
 
-const float SEUIL_VALIDATION = 10.0f; /**< Note minimale pour valider une UE ou un semestre (10/20) */
-const float SEUIL_BLOQUANT = 8.0f;    /**< Note seuil en dessous de laquelle la compensation est impossible */
 const float NOTE_INCONNUE = -1.0f;    /**< Valeur représentant une note non saisie */
 const float MAX_NOTE = 20.0f;         /**< Note maximale possible */
 
+const char* const NOM_SEGMENT = "/sae_c_promotion"; /**< Nom par défaut du segment de mémoire partagée (option --segment) */
+const unsigned int MAGIQUE_SEGMENT = 0x43454153u;   /**< Marque d'un segment valide ("SAEC") */
+
+/**
+ * @brief Paramètres des histogrammes de DISTRIBUTION.
+ */
+enum {
+	NB_TRANCHES = 10, /**< Nombre de tranches de l'histogramme (largeur MAX_NOTE / NB_TRANCHES) */
+};
+
+/**
+ * @brief Dimensions du mode batch (pipeline lecture / exécution / écriture).
+ */
+enum {
+	CAPACITE_COMMANDES = 1024, /**< Nombre de commandes lues d'avance (puissance de 2) */
+	CAPACITE_BLOCS = 64,       /**< Nombre de blocs de sortie en attente d'écriture (puissance de 2) */
+	TAILLE_BLOC = 16384,       /**< Taille d'un bloc de sortie */
+	TAILLE_LIGNE_CACHE = 64,   /**< Alignement évitant le faux partage entre threads */
+	ESSAIS_AVANT_PAUSE = 64,   /**< Attentes actives avant de s'endormir sur une file vide ou pleine */
+	DUREE_PAUSE_NS = 50000,    /**< Durée d'une pause d'attente (ns) */
+};
+
+/**
+ * @brief Dimensions du mode silencieux (QUIET).
+ */
+enum {
+	MAX_LIGNES_ERREUR = 20, /**< Nombre de lignes mémorisées par type d'erreur */
+};
+
+/**
+ * @brief Dimensions du cache des cursus affichés.
+ */
+enum {
+	TAILLE_RENDU_CURSUS = 2 * MAX_NOM + 16 + (MAX_SEMESTRES + MAX_ANNEES) * (32 + 16 * MAX_UE), /**< Taille maximale du texte d'un CURSUS (une ligne par semestre et par année, au plus 16 caractères par UE) */
+};
+
+/**
+ * @brief Dimensions de l'historique des modifications.
+ */
+enum {
+	MAX_EVENEMENTS = 65536,  /**< Nombre maximal d'événements enregistrés */
+	INTERVALLE_POINTS = 16,  /**< Nombre d'événements d'un étudiant entre deux points de reprise */
+	MAX_POINTS = MAX_EVENEMENTS / INTERVALLE_POINTS + MAX_ETUDIANTS, /**< Nombre maximal de points de reprise */
+};
+
 // ============================================================================
 // TYPES
 // ============================================================================
@@ -65,258 +190,1142 @@ typedef enum {
 	DIPLOME,     /**< Étudiant ayant validé son diplôme */
 } t_statut;
 
+/**
+ * @brief Code de validation d'une note ou d'une moyenne annuelle.
+ */
+typedef enum {
+	CODE_ADM, /**< Admis */
+	CODE_ADC, /**< Admis par compensation RCUE */
+	CODE_ADS, /**< Admis par compensation Année Suivante */
+	CODE_AJ,  /**< Ajourné */
+	CODE_AJB, /**< Ajourné (moyenne sous le seuil bloquant) */
+	NB_CODES, /**< Nombre de codes */
+} t_code;
+
+const char* const LIBELLES_CODES[NB_CODES] = { "ADM", "ADC", "ADS", "AJ", "AJB" }; /**< Libellés affichés des codes */
+
+/**
+ * @brief Catégorie d'un étudiant dans le bilan d'une année.
+ */
+typedef enum {
+	BILAN_AUCUNE,        /**< L'étudiant ne compte pas pour cette année */
+	BILAN_DEMISSION,     /**< Démissionnaire pendant l'année */
+	BILAN_DEFAILLANCE,   /**< Défaillant pendant l'année */
+	BILAN_EN_COURS,      /**< En cours dans l'année */
+	BILAN_AJOURNE,       /**< Ajourné à la fin de l'année */
+	BILAN_PASSE,         /**< Passé à l'année suivante ou diplômé */
+	NB_CATEGORIES_BILAN, /**< Nombre de catégories */
+} t_categorie_bilan;
+
+const char* const LIBELLES_BILAN[NB_CATEGORIES_BILAN] = {
+	"", "demission(s)", "defaillance(s)", "en cours", "ajourne(s)", "passe(s)"
+}; /**< Libellés affichés des catégories du bilan */
+
 /**
  * @brief Structure représentant un étudiant.
  */
 typedef struct {
 	char prenom[MAX_NOM + 1];        /**< Prénom de l'étudiant */
 	char nom[MAX_NOM + 1];           /**< Nom de l'étudiant */
-	float notes[NB_SEMESTRES][NB_UE];/**< Tableau des notes (semestre, UE) */
-	int semestre_actuel;             /**< Numéro du semestre actuel (1 à 6) */
+	float notes[MAX_SEMESTRES][MAX_UE]; /**< Tableau des notes (semestre, UE) */
+	int semestre_actuel;             /**< Numéro du semestre actuel (1 à 6 en BUT) */
 	t_statut statut;                 /**< Statut actuel de l'étudiant */
 } t_etudiant;
 
+/**
+ * @brief Description d'une formation (une ligne de LISTE_FORMATIONS).
+ *
+ * Les fonctions pointées sont les versions spécialisées pour cette formation :
+ * le choix de la formation coûte un appel indirect par étudiant, les boucles
+ * sur les UE et les années étant de taille fixe à l'intérieur.
+ */
+typedef struct {
+	const char* nom;         /**< Nom de la formation (option --formation) */
+	int nb_annees;           /**< Nombre d'années */
+	int nb_semestres;        /**< Nombre de semestres (deux par année) */
+	int nb_ue;               /**< Nombre d'UE par semestre */
+	int min_rcue_valides;    /**< UE à valider pour passer à l'année suivante */
+	float seuil_validation;  /**< Note minimale pour valider une UE */
+	float seuil_bloquant;    /**< Note en dessous de laquelle la compensation est impossible */
+	void (*jury_fin_annee)(t_etudiant* etu, int annee);            /**< Jury de fin d'année */
+	void (*afficher_cursus)(int id_etu, const t_etudiant* etu);    /**< Affichage du cursus */
+	int (*semestre_complet)(const t_etudiant* etu, int idx_sem);   /**< 1 si toutes les notes du semestre sont saisies */
+} t_formation;
+
+extern const t_formation FORMATIONS[NB_FORMATIONS]; /**< Formations disponibles, dans l'ordre de LISTE_FORMATIONS */
+
+/**
+ * @brief Type d'une modification enregistrée dans l'historique.
+ */
+typedef enum {
+	EVT_INSCRIPTION, /**< Inscription de l'étudiant */
+	EVT_NOTE,        /**< Saisie ou correction d'une note */
+	EVT_SEMESTRE,    /**< Changement de semestre */
+	EVT_STATUT,      /**< Changement de statut */
+} t_type_evenement;
+
+/**
+ * @brief Modification élémentaire d'un étudiant (seul le champ modifié est stocké).
+ */
+typedef struct {
+	unsigned char type;    /**< Type de modification (t_type_evenement) */
+	unsigned char idx_etu; /**< Index de l'étudiant modifié */
+	unsigned char idx_sem; /**< Index du semestre (EVT_NOTE) */
+	unsigned char idx_ue;  /**< Index de l'UE (EVT_NOTE) */
+	float valeur;          /**< Nouvelle note, nouveau semestre ou nouveau statut */
+	int precedent;         /**< Événement précédent du même étudiant (-1 si aucun) */
+} t_evenement;
+
+/**
+ * @brief Copie complète d'un étudiant juste après l'un de ses événements.
+ */
+typedef struct {
+	t_etudiant etat; /**< État de l'étudiant après l'événement */
+	int evenement;   /**< Index de l'événement couvert par le point de reprise */
+	int precedent;   /**< Point de reprise précédent du même étudiant (-1 si aucun) */
+} t_point_reprise;
+
+/**
+ * @brief Historique en ajout seul des modifications de la promotion.
+ *
+ * La version N désigne l'état de la promotion après les N premières commandes
+ * l'ayant modifiée, soit ses fin_versions[N] premiers événements : une
+ * commande modifiant plusieurs notes ou étudiants (NOTES, JURY) n'est
+ * jamais visible à moitié appliquée. Une fois le journal plein, les
+ * versions ne progressent plus : la dernière reste celle de la dernière
+ * commande entièrement enregistrée.
+ * Les événements et les points de reprise de chaque étudiant sont chaînés
+ * pour reconstruire un étudiant sans parcourir ceux des autres.
+ */
+typedef struct {
+	t_evenement evenements[MAX_EVENEMENTS];  /**< Journal des événements */
+	int nb_evenements;                       /**< Nombre d'événements */
+	int nb_versions;                         /**< Nombre de versions (version actuelle) */
+	int plein;                               /**< 1 si des événements n'ont pas pu être enregistrés */
+	int fin_versions[MAX_EVENEMENTS + 1];    /**< Nombre d'événements pris en compte à chaque version */
+	t_point_reprise points[MAX_POINTS];      /**< Points de reprise */
+	int nb_points;                           /**< Nombre de points de reprise */
+	int dernier_evenement[MAX_ETUDIANTS];    /**< Dernier événement de chaque étudiant */
+	int dernier_point[MAX_ETUDIANTS];        /**< Dernier point de reprise de chaque étudiant */
+	int nb_evenements_etu[MAX_ETUDIANTS];    /**< Nombre d'événements de chaque étudiant */
+} t_historique;
+
 /**
  * @brief Structure représentant une promotion d'étudiants.
+ *
+ * Les étudiants sont rangés par identifiant. Seuls les étudiants EN_COURS
+ * peuvent encore changer : les parcours des jurys et du bilan ne visitent
+ * qu'eux, via la liste actifs. Les autres (diplômés, ajournés,
+ * démissionnaires, défaillants) en sont retirés par archiver_termines, et
+ * leur part du bilan, définitive, est comptée une fois pour toutes.
  */
 typedef struct {
 	t_etudiant etudiants[MAX_ETUDIANTS]; /**< Tableau des étudiants inscrits */
 	int nb_inscrits;                     /**< Nombre actuel d'étudiants inscrits */
+	t_historique historique;             /**< Historique des modifications */
+#ifdef PROMOTION_PARTAGEE
+	atomic_uint generation;              /**< Compteur de modifications (impair pendant une modification) */
+#else
+	unsigned int generation;             /**< Compteur de modifications (impair pendant une modification) */
+#endif
+	int actifs[MAX_ETUDIANTS];           /**< Index des étudiants EN_COURS, par ordre d'inscription */
+	int nb_actifs;                       /**< Nombre d'étudiants EN_COURS */
+	int bilan_archives[MAX_ANNEES][NB_CATEGORIES_BILAN]; /**< Contribution au bilan des étudiants sortis de formation */
+	int num_formation;                   /**< Formation suivie par la promotion (index dans FORMATIONS) */
+	unsigned int revisions[MAX_ETUDIANTS]; /**< Compteur de modifications de chaque étudiant (cache des CURSUS) */
 } t_promotion;
 
+/**
+ * @brief Disposition d'un segment de mémoire partagée (NOM_SEGMENT par défaut).
+ *
+ * Le processus principal lancé avec --publier ou --segment crée le segment
+ * (qui ne doit pas déjà exister),
+ * y place sa promotion et la modifie en place.
+ * Les processus de rapport (--rapport) projettent le segment en lecture
+ * seule et vérifient magique, taille et que le processus principal existe
+ * encore avant de l'utiliser. Une lecture est cohérente si
+ * promo.generation est pair et inchangé avant et après.
+ */
+typedef struct {
+	unsigned int magique; /**< MAGIQUE_SEGMENT une fois la promotion initialisée */
+	unsigned int taille;  /**< sizeof(t_segment_promotion) du processus principal */
+	long pid;             /**< Processus principal qui publie la promotion */
+	t_promotion promo;    /**< Promotion publiée */
+} t_segment_promotion;
+
+/**
+ * @brief Commandes reconnues par l'interpréteur.
+ */
+typedef enum {
+	CMD_INCONNUE,     /**< Mot non reconnu (ignoré) */
+	CMD_EXIT,         /**< Fin du programme (ou fin de l'entrée) */
+	CMD_INSCRIRE,     /**< INSCRIRE prenom nom */
+	CMD_NOTE,         /**< NOTE id ue note */
+	CMD_CURSUS,       /**< CURSUS id [@version] */
+	CMD_ETUDIANTS,    /**< ETUDIANTS */
+	CMD_DEMISSION,    /**< DEMISSION id */
+	CMD_DEFAILLANCE,  /**< DEFAILLANCE id */
+	CMD_JURY,         /**< JURY semestre */
+	CMD_BILAN,        /**< BILAN annee */
+	CMD_DISTRIBUTION, /**< DISTRIBUTION periode */
+	CMD_SIMULER_JURY, /**< SIMULER_JURY semestre */
+	CMD_VERSION,      /**< VERSION */
+	CMD_QUIET,        /**< QUIET */
+	CMD_NOTES,        /**< NOTES id n1 ... n6 (ou une ligne d'un bloc NOTES BLOC k) */
+} t_type_commande;
+
+/**
+ * @brief Erreurs des commandes de saisie (INSCRIRE, NOTE, DEMISSION, DEFAILLANCE).
+ */
+typedef enum {
+	ERR_IDENTIFIANT,    /**< Identifiant incorrect */
+	ERR_NOM,            /**< Nom incorrect (doublon) */
+	ERR_HORS_FORMATION, /**< Étudiant hors formation */
+	ERR_UE,             /**< UE incorrecte */
+	ERR_NOTE,           /**< Note incorrecte */
+	NB_ERREURS,         /**< Nombre de types d'erreur */
+} t_erreur;
+
+const char* const LIBELLES_ERREURS[NB_ERREURS] = {
+	"Identifiant incorrect", "Nom incorrect", "Etudiant hors formation", "UE incorrecte", "Note incorrecte"
+}; /**< Messages affichés des erreurs */
+
+/**
+ * @brief État du mode silencieux.
+ *
+ * En mode silencieux, les commandes de saisie n'affichent plus leur
+ * confirmation, et leurs erreurs sont comptées par type avec leurs numéros
+ * de ligne pour être affichées en un seul résumé à la fin.
+ */
+typedef struct {
+	int actif;                                          /**< 1 si le mode silencieux est activé */
+	int ligne;                                          /**< Ligne de la commande en cours d'exécution */
+	int nb_erreurs[NB_ERREURS];                         /**< Nombre d'erreurs de chaque type */
+	int lignes[NB_ERREURS][MAX_LIGNES_ERREUR];          /**< Premières lignes en erreur de chaque type */
+} t_mode_silencieux;
+
+/**
+ * @brief Commande lue et décodée, prête à être exécutée.
+ */
+typedef struct {
+	t_type_commande type;      /**< Commande */
+	int ligne;                 /**< Numéro de ligne de la commande dans l'entrée */
+	int id_etu;                /**< Identifiant de l'étudiant */
+	int num_ue;                /**< Numéro d'UE (NOTE) */
+	int numero;                /**< Semestre (JURY, SIMULER_JURY) ou année (BILAN) */
+	int avec_version;          /**< 1 si une version est précisée (CURSUS) */
+	int version;               /**< Version demandée (CURSUS) */
+	float note;                /**< Note (NOTE) */
+	float notes[MAX_UE];       /**< Notes de chaque UE (NOTES), NOTE_INCONNUE si non saisie */
+	char prenom[MAX_NOM + 1];  /**< Prénom (INSCRIRE) */
+	char nom[MAX_NOM + 1];     /**< Nom (INSCRIRE) */
+	char periode[MAX_NOM + 1]; /**< Période S<n> ou B<n> (DISTRIBUTION) */
+} t_commande;
+
+/**
+ * @brief État de la lecture des commandes d'un flux.
+ */
+typedef struct {
+	FILE* entree;        /**< Flux lu */
+	int ligne;           /**< Numéro de ligne courant */
+	int notes_restantes; /**< Lignes restant à lire dans un bloc NOTES BLOC */
+	int nb_ue;           /**< Nombre de notes d'une ligne NOTES (UE de la formation) */
+} t_lecteur;
+
+#ifdef MODE_BATCH
+/**
+ * @brief File circulaire à un producteur et un consommateur, sans verrou.
+ *
+ * Seuls les indices sont partagés : les cases sont dans un tableau à part,
+ * remplies en place par le producteur puis lues en place par le consommateur.
+ */
+typedef struct {
+	_Alignas(TAILLE_LIGNE_CACHE) atomic_size_t tete;  /**< Nombre de cases libérées par le consommateur */
+	_Alignas(TAILLE_LIGNE_CACHE) atomic_size_t queue; /**< Nombre de cases publiées par le producteur */
+} t_anneau;
+#endif
+
+/**
+ * @brief Bloc de texte produit par l'exécution, en attente d'écriture.
+ */
+typedef struct {
+	size_t taille;            /**< Nombre d'octets utilisés */
+	int fin;                  /**< 1 pour le dernier bloc */
+	char texte[TAILLE_BLOC];  /**< Texte à écrire */
+} t_bloc_sortie;
+
+/**
+ * @brief Texte du CURSUS actuel d'un étudiant, conservé tant qu'il ne change pas.
+ */
+typedef struct {
+	int valide;                        /**< 1 si le texte a été rendu */
+	unsigned int revision;             /**< Révision de l'étudiant au moment du rendu */
+	size_t taille;                     /**< Nombre d'octets du texte */
+	char texte[TAILLE_RENDU_CURSUS];   /**< Texte affiché par CURSUS */
+} t_rendu_cursus;
+
+#ifdef MODE_BATCH
+/**
+ * @brief Pipeline du mode batch : lecture, exécution et écriture sur trois threads.
+ */
+typedef struct {
+	t_lecteur lecteur;                           /**< Lecture des commandes */
+	t_anneau anneau_commandes;                   /**< Lecture -> exécution */
+	t_commande commandes[CAPACITE_COMMANDES];    /**< Cases des commandes */
+	t_anneau anneau_blocs;                       /**< Exécution -> écriture */
+	t_bloc_sortie blocs[CAPACITE_BLOCS];         /**< Cases des blocs de sortie */
+	t_bloc_sortie* bloc_courant;                 /**< Bloc en cours de remplissage (NULL si aucun) */
+} t_pipeline;
+#endif
+
 // ============================================================================
 // PROTOTYPES
 // ============================================================================
 
+// Entrées / sorties
+int lire_mot(FILE* entree, char* mot, int taille, int* ligne);
+int lire_mot_ligne(FILE* entree, char* mot, int taille);
+void lire_notes(t_lecteur* lecteur, t_commande* cmd, const char* id);
+void lire_commande(t_lecteur* lecteur, t_commande* cmd);
+int executer_commande(t_promotion* promo, const t_commande* cmd);
+int executer_requete(const t_promotion* promo, const t_commande* cmd);
+void ecrire(const char* format, ...);
+void signaler_erreur(t_erreur erreur);
+void afficher_resume_erreurs(void);
+
 // Initialisation
-void init_promotion(t_promotion* promo);
+void init_promotion(t_promotion* promo, int num_formation);
 
 // Sprint 1
-void cmd_inscrire(t_promotion* promo);
-void cmd_note(t_promotion* promo);
-void cmd_cursus(const t_promotion* promo);
+void cmd_inscrire(t_promotion* promo, const char* prenom_saisi, const char* nom_saisi);
+void cmd_note(t_promotion* promo, int id_etu, int num_ue, float note);
+void cmd_notes(t_promotion* promo, int id_etu, const float notes[MAX_UE]);
+void cmd_cursus(const t_promotion* promo, int id_etu, int avec_version, int version);
+SPECIALISE void afficher_cursus(int id_etu, const t_etudiant* etu, int nb_annees, int nb_ue,
+	float seuil_validation, float seuil_bloquant);
 void cmd_etudiants(const t_promotion* promo);
 float calculer_moyenne_annee(const t_etudiant* etu, int annee, int num_ue);
-void afficher_note_avec_code(float note, float moy_annee, float moy_suivante);
-void afficher_moyenne_avec_code(float moy_annee, float moy_suivante);
+int jury_annee_fait(const t_etudiant* etu, int annee);
+t_code code_note(float note, float moy_annee, float moy_suivante, float seuil_validation);
+t_code code_moyenne(float moy_annee, float moy_suivante, float seuil_validation, float seuil_bloquant);
+void afficher_note_avec_code(float note, float moy_annee, float moy_suivante, float seuil_validation);
+void afficher_moyenne_avec_code(float moy_annee, float moy_suivante, float seuil_validation, float seuil_bloquant);
 void afficher_statut(t_statut statut);
 
 // Sprint 2
-void cmd_changer_statut(t_promotion* promo, t_statut nouveau_statut);
-void cmd_jury(t_promotion* promo);
+void cmd_changer_statut(t_promotion* promo, int id_etu, t_statut nouveau_statut);
+void cmd_jury(t_promotion* promo, int num_sem);
 int verif_notes_incompletes(const t_promotion* promo, int num_sem);
+SPECIALISE int semestre_complet(const t_etudiant* etu, int idx_sem, int nb_ue);
 int passer_semestre_suivant(t_promotion* promo, int num_sem);
+void archiver_termines(t_promotion* promo);
 
 // Sprint 3
-void jury_fin_annee(t_etudiant* etu, int annee);
+SPECIALISE void jury_fin_annee(t_etudiant* etu, int annee, int nb_annees, int nb_ue, int min_rcue_valides,
+	float seuil_validation, float seuil_bloquant);
 
 // Sprint 4
-void cmd_bilan(const t_promotion* promo);
+void cmd_bilan(const t_promotion* promo, int annee);
+t_categorie_bilan categorie_bilan(const t_etudiant* etu, int annee, int nb_annees);
+
+// Sprint 5
+void cmd_distribution(const t_promotion* promo, const char* periode);
+void cmd_simuler_jury(const t_promotion* promo, int num_sem);
+
+// Sprint 6
+void historique_enregistrer(t_promotion* promo, int idx, t_type_evenement type, int idx_sem, int idx_ue, float valeur);
+void historique_valider(t_promotion* promo);
+int reconstruire_etudiant(const t_promotion* promo, int idx, int nb_evenements, t_etudiant* etat);
+void cmd_version(const t_promotion* promo);
+
+// Sprint 7
+#ifdef MODE_BATCH
+void anneau_patienter(int* essais);
+void anneau_init(t_anneau* anneau);
+size_t anneau_reserver(t_anneau* anneau, size_t capacite);
+void anneau_publier(t_anneau* anneau);
+size_t anneau_attendre(t_anneau* anneau, size_t capacite);
+void anneau_liberer(t_anneau* anneau);
+void* thread_lecture(void* arg);
+void* thread_ecriture(void* arg);
+void pipeline_ecrire(t_pipeline* pipeline, const char* format, va_list args);
+void pipeline_publier_bloc(t_pipeline* pipeline, int fin);
+#endif
+int executer_pipeline(t_promotion* promo, FILE* entree);
+
+// Sprint 8
+t_promotion* publier_promotion(int num_formation, const char* nom_segment);
+void retirer_promotion(t_promotion* promo);
+void debut_modification(t_promotion* promo);
+void fin_modification(t_promotion* promo);
+int executer_rapport(FILE* entree, const char* nom_segment);
+int segment_abandonne(const char* nom_segment);
+
+// Sprint 10
+void marquer_cursus_modifie(t_promotion* promo, int idx);
+void afficher_cursus_cache(const t_promotion* promo, int idx);
+void vider_cache_cursus(void);
 
 // ============================================================================
 // MAIN
 // ============================================================================
 
+#ifdef MODE_BATCH
+/**
+ * @brief Sortie des commandes en mode batch (NULL : écriture directe sur stdout).
+ */
+static t_pipeline* pipeline_sortie = NULL;
+#endif
+
+/**
+ * @brief Mode silencieux (désactivé au démarrage).
+ */
+static t_mode_silencieux mode_silencieux;
+
+/**
+ * @brief Tampon recevant les sorties d'une requête en cours de lecture (NULL : aucun).
+ */
+static t_bloc_sortie* capture_sortie = NULL;
+
+#ifdef PROMOTION_PARTAGEE
+/**
+ * @brief Segment créé par publier_promotion (NULL : promotion locale au processus).
+ */
+static t_segment_promotion* segment_publie = NULL;
+
+/**
+ * @brief Nom du segment créé par publier_promotion.
+ */
+static const char* nom_segment_publie = NULL;
+#endif
+
+/**
+ * @brief CURSUS actuels déjà rendus, par index d'étudiant (propres au processus).
+ */
+static t_rendu_cursus cache_cursus[MAX_ETUDIANTS];
+
 /**
  * @brief Point d'entrée du programme.
  *
  * Boucle principale qui lit les commandes utilisateur et appelle les
- * fonctions appropriées.
+ * fonctions appropriées. Avec l'option --batch, la lecture, l'exécution
+ * et l'écriture sont réparties sur trois threads (voir executer_pipeline).
+ * L'option --formation NOM choisit la formation de la promotion (BUT par défaut).
+ * Avec l'option --publier, la promotion est publiée en mémoire partagée
+ * pour les processus lancés avec l'option --rapport, qui ne répondent
+ * qu'aux requêtes. L'option --segment NOM choisit le segment (NOM_SEGMENT
+ * par défaut) et implique --publier, ce qui permet de publier plusieurs
+ * promotions. Sans ces options, la promotion reste locale au processus et
+ * plusieurs exécutions peuvent avoir lieu en même temps.
  *
- * @return 0 en cas de succès.
+ * @param argc Nombre d'arguments.
+ * @param argv Arguments de la ligne de commande.
+ * @return 0 en cas de succès, 1 si les options sont incorrectes ou le segment déjà utilisé.
  */
-int main() {
-	char cmd[MAX_NOM + 1];
-	t_promotion promo;
-
-	init_promotion(&promo);
-
-	while (1) {
-		scanf("%s", cmd);
-
-		if (strcmp(cmd, "EXIT") == 0) {
-			break;
+int main(int argc, char* argv[]) {
+	int batch = 0;
+	int rapport = 0;
+	int publier = 0;
+	int num_formation = FORMATION_BUT;
+	const char* nom_segment = NOM_SEGMENT;
+
+	for (int i = 1; i < argc; i++) {
+		if (strcmp(argv[i], "--rapport") == 0) {
+			rapport = 1;
 		}
-		else if (strcmp(cmd, "INSCRIRE") == 0) {
-			cmd_inscrire(&promo);
+		else if (strcmp(argv[i], "--publier") == 0) {
+			publier = 1;
 		}
-		else if (strcmp(cmd, "NOTE") == 0) {
-			cmd_note(&promo);
+		else if (strcmp(argv[i], "--segment") == 0 && i + 1 < argc) {
+			nom_segment = argv[++i];
+			publier = 1;
 		}
-		else if (strcmp(cmd, "CURSUS") == 0) {
-			cmd_cursus(&promo);
+		else if (strcmp(argv[i], "--batch") == 0) {
+			batch = 1;
 		}
-		else if (strcmp(cmd, "ETUDIANTS") == 0) {
-			cmd_etudiants(&promo);
-		}
-		else if (strcmp(cmd, "DEMISSION") == 0) {
-			cmd_changer_statut(&promo, DEMISSION);
-		}
-		else if (strcmp(cmd, "DEFAILLANCE") == 0) {
-			cmd_changer_statut(&promo, DEFAILLANCE);
-		}
-		else if (strcmp(cmd, "JURY") == 0) {
-			cmd_jury(&promo);
-		}
-		else if (strcmp(cmd, "BILAN") == 0) {
-			cmd_bilan(&promo);
+		else if (strcmp(argv[i], "--formation") == 0) {
+			const char* nom = (i + 1 < argc) ? argv[++i] : "";
+
+			num_formation = 0;
+			while (num_formation < NB_FORMATIONS && strcmp(FORMATIONS[num_formation].nom, nom) != 0) {
+				num_formation++;
+			}
+			if (num_formation == NB_FORMATIONS) {
+				fprintf(stderr, "Formation inconnue\n");
+				return 1;
+			}
 		}
 	}
 
+	if (rapport) {
+		return executer_rapport(stdin, nom_segment);
+	}
+
+	t_promotion* promo = publier_promotion(num_formation, publier ? nom_segment : NULL);
+
+	if (promo == NULL) {
+		fprintf(stderr, "Segment deja utilise\n");
+		return 1;
+	}
+
+	if (!(batch && executer_pipeline(promo, stdin))) {
+		t_commande cmd;
+		t_lecteur lecteur = { stdin, 1, 0, FORMATIONS[num_formation].nb_ue };
+
+		do {
+			lire_commande(&lecteur, &cmd);
+		} while (executer_commande(promo, &cmd));
+	}
+
+	retirer_promotion(promo);
 	return 0;
 }
 
 // ============================================================================
-// INITIALISATION
+// LECTURE ET EXECUTION DES COMMANDES
 // ============================================================================
 
 /**
- * @brief Initialise la promotion avec des valeurs par défaut.
+ * @brief Lit le prochain mot de l'entrée.
  *
- * Met à zéro le nombre d'inscrits et initialise toutes les notes à NOTE_INCONNUE.
- * Initialise également le statut et le semestre des emplacements vides.
+ * Ignore les blancs en comptant les fins de ligne, puis lit les caractères
+ * jusqu'au prochain blanc (tronqué à taille - 1 caractères).
  *
- * @param promo Pointeur vers la structure de promotion à initialiser.
+ * @param entree Flux lu.
+ * @param mot Tampon recevant le mot.
+ * @param taille Taille du tampon.
+ * @param ligne Numéro de ligne courant, mis à jour.
+ * @return 1 si un mot a été lu, 0 en fin d'entrée.
  */
-void init_promotion(t_promotion* promo) {
-	assert(promo != NULL);
+int lire_mot(FILE* entree, char* mot, int taille, int* ligne) {
+	assert(entree != NULL && mot != NULL && taille > 0 && ligne != NULL);
 
-	promo->nb_inscrits = 0;
+	int c = LIRE_CARACTERE(entree);
+	while (c == ' ' || c == '\t' || c == '\r' || c == '\n') {
+		if (c == '\n') {
+			(*ligne)++;
+		}
+		c = LIRE_CARACTERE(entree);
+	}
 
-	for (int i = 0; i < MAX_ETUDIANTS; i++) {
-		for (int sem = 0; sem < NB_SEMESTRES; sem++) {
-			for (int ue = 0; ue < NB_UE; ue++) {
-				promo->etudiants[i].notes[sem][ue] = NOTE_INCONNUE;
-			}
+	int lg = 0;
+	while (c != EOF && c != ' ' && c != '\t' && c != '\r' && c != '\n') {
+		if (lg < taille - 1) {
+			mot[lg++] = (char)c;
 		}
-		promo->etudiants[i].statut = EN_COURS;
-		promo->etudiants[i].semestre_actuel = 1;
+		c = LIRE_CARACTERE(entree);
 	}
-}
+	mot[lg] = '\0';
 
-// ============================================================================
-// SPRINT 1 - Commandes de base
-// ============================================================================
+	if (c != EOF) {
+		REMETTRE_CARACTERE(c, entree); // La fin de ligne sera comptée au prochain mot
+	}
+
+	return lg > 0;
+}
 
-// --- INSCRIRE ---
 /**
- * @brief Inscrit un nouvel étudiant dans la promotion.
+ * @brief Lit le prochain mot de la ligne courante.
  *
- * Lit le prénom et le nom depuis l'entrée standard.
- * Vérifie si l'étudiant existe déjà (doublon).
- * Si la promotion n'est pas pleine, ajoute l'étudiant.
+ * Comme lire_mot, mais s'arrête à la fin de la ligne sans la consommer :
+ * un argument manquant ne fait pas lire la commande suivante.
  *
- * @param promo Pointeur vers la promotion.
+ * @param entree Flux lu.
+ * @param mot Tampon recevant le mot (vide en fin de ligne).
+ * @param taille Taille du tampon.
+ * @return 1 si un mot a été lu, 0 en fin de ligne ou d'entrée.
  */
-void cmd_inscrire(t_promotion* promo) {
-	assert(promo != NULL);
-
-	char prenom_saisi[MAX_NOM + 1];
-	char nom_saisi[MAX_NOM + 1];
-	int doublon = 0;
+int lire_mot_ligne(FILE* entree, char* mot, int taille) {
+	assert(entree != NULL && mot != NULL && taille > 0);
 
-	scanf("%s %s", prenom_saisi, nom_saisi);
+	int c;
+	do {
+		c = LIRE_CARACTERE(entree);
+	} while (c == ' ' || c == '\t' || c == '\r');
 
-	// Vérifier si l'étudiant existe déjà
-	for (int i = 0; i < promo->nb_inscrits; i++) {
-		if (strcmp(promo->etudiants[i].nom, nom_saisi) == 0 &&
-			strcmp(promo->etudiants[i].prenom, prenom_saisi) == 0) {
-			doublon = 1;
-			break;
-		}
+	if (c != EOF) {
+		REMETTRE_CARACTERE(c, entree);
 	}
 
-	if (doublon) {
-		printf("Nom incorrect\n");
+	if (c == EOF || c == '\n') {
+		mot[0] = '\0';
+		return 0;
 	}
-	else {
-		if (promo->nb_inscrits < MAX_ETUDIANTS) {
-			int pos = promo->nb_inscrits;
 
-			strcpy(promo->etudiants[pos].nom, nom_saisi);
-			strcpy(promo->etudiants[pos].prenom, prenom_saisi);
-			promo->etudiants[pos].statut = EN_COURS;
-			promo->etudiants[pos].semestre_actuel = 1;
-
-			promo->nb_inscrits++;
-			printf("Inscription enregistree (%d)\n", promo->nb_inscrits);
-		}
-	}
+	int ligne = 0;
+	return lire_mot(entree, mot, taille, &ligne);
 }
 
-// --- NOTE ---
 /**
- * @brief Enregistre ou modifie la note d'un étudiant.
+ * @brief Lit les notes (une par UE de la formation) d'une commande NOTES.
  *
- * Lit l'ID étudiant, le numéro d'UE et la note.
- * Effectue des vérifications (ID valide, étudiant en cours, UE valide, note valide).
- * Enregistre la note pour le semestre actuel de l'étudiant.
+ * Les notes sont lues sur la ligne de la commande uniquement. Une note *
+ * n'est pas saisie (NOTE_INCONNUE). Une note illisible, négative ou
+ * manquante est remplacée par une valeur hors bornes pour être refusée
+ * (une note saisie ne peut pas être confondue avec NOTE_INCONNUE), de
+ * même qu'une ligne ayant trop de notes, dont le reste est ignoré.
+ * Les UE au-delà de celles de la formation valent NOTE_INCONNUE.
  *
- * @param promo Pointeur vers la promotion.
+ * @param lecteur État de la lecture.
+ * @param cmd Commande NOTES à compléter.
+ * @param id Identifiant déjà lu (refusé par cmd_notes s'il n'est pas un nombre).
  */
-void cmd_note(t_promotion* promo) {
-	assert(promo != NULL);
+void lire_notes(t_lecteur* lecteur, t_commande* cmd, const char* id) {
+	assert(lecteur != NULL && cmd != NULL && id != NULL);
 
-	int id_etu, num_ue;
-	float note;
+	char mot[MAX_NOM + 1];
 
-	scanf("%d %d %f", &id_etu, &num_ue, &note);
+	cmd->type = CMD_NOTES;
+	cmd->id_etu = atoi(id);
 
-	// Validation de l'ID
-	if (id_etu <= 0 || id_etu > promo->nb_inscrits) {
-		printf("Identifiant incorrect\n");
-		return;
-	}
+	for (int ue = 0; ue < lecteur->nb_ue; ue++) {
+		lire_mot_ligne(lecteur->entree, mot, sizeof(mot));
 
-	int idx = id_etu - 1;
+		char* fin;
+		float note = strtof(mot, &fin);
 
-	// Vérifier que l'étudiant est EN_COURS
-	if (promo->etudiants[idx].statut != EN_COURS) {
-		printf("Etudiant hors formation\n");
-		return;
+		if (strcmp(mot, "*") == 0) {
+			note = NOTE_INCONNUE;
+		}
+		else if (fin == mot || *fin != '\0' || !(note >= 0.0f)) {
+			note = -MAX_NOTE; // Illisible, négative ou NaN : refusée par la vérification des bornes
+		}
+		cmd->notes[ue] = note;
 	}
+	if (lire_mot_ligne(lecteur->entree, mot, sizeof(mot))) {
+		cmd->notes[0] = -MAX_NOTE; // Trop de notes : ligne refusée
+		while (lire_mot_ligne(lecteur->entree, mot, sizeof(mot))) {
+		}
+	}
+	for (int ue = lecteur->nb_ue; ue < MAX_UE; ue++) {
+		cmd->notes[ue] = NOTE_INCONNUE;
+	}
+}
 
-	// Validation du numéro d'UE
-	if (num_ue < 1 || num_ue > NB_UE) {
-		printf("UE incorrecte\n");
+/**
+ * @brief Lit et décode la prochaine commande de l'entrée.
+ *
+ * Lit le nom de la commande puis ses arguments. Un argument numérique
+ * illisible vaut 0. La fin de l'entrée est traitée comme EXIT.
+ * Après NOTES BLOC k, les k lignes suivantes sont décodées comme autant
+ * de commandes NOTES (id n1 ... n6, sans le nom de la commande).
+ *
+ * @param lecteur État de la lecture, mis à jour.
+ * @param cmd Commande décodée.
+ */
+void lire_commande(t_lecteur* lecteur, t_commande* cmd) {
+	assert(lecteur != NULL && cmd != NULL);
+
+	FILE* entree = lecteur->entree;
+	int* ligne = &lecteur->ligne;
+
+	static const struct {
+		const char* nom;
+		t_type_commande type;
+	} commandes[] = {
+		{ "EXIT", CMD_EXIT },
+		{ "INSCRIRE", CMD_INSCRIRE },
+		{ "NOTE", CMD_NOTE },
+		{ "CURSUS", CMD_CURSUS },
+		{ "ETUDIANTS", CMD_ETUDIANTS },
+		{ "DEMISSION", CMD_DEMISSION },
+		{ "DEFAILLANCE", CMD_DEFAILLANCE },
+		{ "JURY", CMD_JURY },
+		{ "BILAN", CMD_BILAN },
+		{ "DISTRIBUTION", CMD_DISTRIBUTION },
+		{ "SIMULER_JURY", CMD_SIMULER_JURY },
+		{ "VERSION", CMD_VERSION },
+		{ "QUIET", CMD_QUIET },
+		{ "NOTES", CMD_NOTES },
+	};
+
+	char mot[MAX_NOM + 1];
+
+	cmd->type = CMD_INCONNUE;
+	cmd->avec_version = 0;
+
+	if (lecteur->notes_restantes > 0) {
+		lecteur->notes_restantes--;
+		if (!lire_mot(entree, mot, sizeof(mot), ligne)) {
+			lecteur->notes_restantes = 0; // Bloc interrompu par la fin de l'entrée
+			cmd->type = CMD_EXIT;
+			return;
+		}
+		cmd->ligne = *ligne;
+		lire_notes(lecteur, cmd, mot);
 		return;
 	}
 
-	// Validation de la note
-	if (note < 0.0f || note > MAX_NOTE) {
-		printf("Note incorrecte\n");
+	if (!lire_mot(entree, mot, sizeof(mot), ligne)) {
+		cmd->type = CMD_EXIT;
 		return;
 	}
+	cmd->ligne = *ligne;
 
-	// Enregistrer la note au semestre actuel
-	int idx_ue = num_ue - 1;
-	int sem_actuel = promo->etudiants[idx].semestre_actuel;
-	int idx_sem = sem_actuel - 1;
+	for (size_t i = 0; i < sizeof(commandes) / sizeof(commandes[0]); i++) {
+		if (strcmp(mot, commandes[i].nom) == 0) {
+			cmd->type = commandes[i].type;
+			break;
+		}
+	}
 
-	promo->etudiants[idx].notes[idx_sem][idx_ue] = note;
-	printf("Note enregistree\n");
+	switch (cmd->type) {
+	case CMD_INSCRIRE:
+		lire_mot(entree, cmd->prenom, sizeof(cmd->prenom), ligne);
+		lire_mot(entree, cmd->nom, sizeof(cmd->nom), ligne);
+		break;
+	case CMD_NOTE:
+		lire_mot(entree, mot, sizeof(mot), ligne);
+		cmd->id_etu = atoi(mot);
+		lire_mot(entree, mot, sizeof(mot), ligne);
+		cmd->num_ue = atoi(mot);
+		lire_mot(entree, mot, sizeof(mot), ligne);
+		cmd->note = (float)atof(mot);
+		break;
+	case CMD_CURSUS: {
+		lire_mot(entree, mot, sizeof(mot), ligne);
+		cmd->id_etu = atoi(mot);
+
+		// Version optionnelle sur la même ligne
+		int c;
+		do {
+			c = LIRE_CARACTERE(entree);
+		} while (c == ' ' || c == '\t');
+
+		if (c == '@') {
+			lire_mot(entree, mot, sizeof(mot), ligne);
+			cmd->avec_version = 1;
+			cmd->version = atoi(mot);
+		}
+		else if (c != EOF) {
+			REMETTRE_CARACTERE(c, entree);
+		}
+		break;
+	}
+	case CMD_DEMISSION:
+	case CMD_DEFAILLANCE:
+		lire_mot(entree, mot, sizeof(mot), ligne);
+		cmd->id_etu = atoi(mot);
+		break;
+	case CMD_JURY:
+	case CMD_BILAN:
+	case CMD_SIMULER_JURY:
+		lire_mot(entree, mot, sizeof(mot), ligne);
+		cmd->numero = atoi(mot);
+		break;
+	case CMD_DISTRIBUTION:
+		lire_mot(entree, cmd->periode, sizeof(cmd->periode), ligne);
+		break;
+	case CMD_NOTES:
+		// NOTES id n1 ... n6, ou NOTES BLOC k suivi de k lignes id n1 ... n6
+		lire_mot_ligne(entree, mot, sizeof(mot));
+
+		if (strcmp(mot, "BLOC") == 0) {
+			lire_mot_ligne(entree, mot, sizeof(mot));
+			lecteur->notes_restantes = atoi(mot);
+			cmd->type = CMD_INCONNUE;
+		}
+		else {
+			lire_notes(lecteur, cmd, mot);
+		}
+		break;
+	default:
+		break;
+	}
 }
 
-// --- Fonctions de calcul ---
-
 /**
- * @brief Calcule la moyenne annuelle (RCUE) pour une UE.
+ * @brief Exécute une commande décodée.
  *
- * Moyenne des notes d'une même UE sur les deux semestres de l'année.
+ * À la fin (EXIT), affiche le résumé des erreurs du mode silencieux.
  *
- * @param etu Pointeur vers l'étudiant.
- * @param annee Année concernée (1, 2 ou 3).
- * @param num_ue Index de l'UE (0 à NB_UE-1).
- * @return La moyenne sur 20, ou NOTE_INCONNUE si une des notes manque.
+ * @param promo Pointeur vers la promotion.
+ * @param cmd Commande à exécuter.
+ * @return 0 si la commande est EXIT, 1 sinon.
  */
-float calculer_moyenne_annee(const t_etudiant* etu, int annee, int num_ue) {
-	assert(etu != NULL && annee >= 1 && annee <= 3 && num_ue >= 0 && num_ue < NB_UE);
-
-	int sem1 = (annee - 1) * 2;
-	int sem2 = (annee - 1) * 2 + 1;
+int executer_commande(t_promotion* promo, const t_commande* cmd) {
+	assert(promo != NULL && cmd != NULL);
 
-	float note1 = etu->notes[sem1][num_ue];
-	float note2 = etu->notes[sem2][num_ue];
+	mode_silencieux.ligne = cmd->ligne;
+
+	if (cmd->type == CMD_EXIT) {
+		afficher_resume_erreurs();
+		return 0;
+	}
+
+	if (executer_requete(promo, cmd)) {
+		return 1;
+	}
+
+	// Commandes sans effet sur la promotion : les processus de rapport n'ont pas à recommencer
+	if (cmd->type == CMD_QUIET) {
+		mode_silencieux.actif = 1;
+		return 1;
+	}
+	if (cmd->type == CMD_INCONNUE) {
+		return 1;
+	}
+
+	// Commandes modifiant la promotion, signalées aux processus de rapport
+	debut_modification(promo);
+
+	switch (cmd->type) {
+	case CMD_INSCRIRE:     cmd_inscrire(promo, cmd->prenom, cmd->nom);           break;
+	case CMD_NOTE:         cmd_note(promo, cmd->id_etu, cmd->num_ue, cmd->note); break;
+	case CMD_NOTES:        cmd_notes(promo, cmd->id_etu, cmd->notes);            break;
+	case CMD_DEMISSION:    cmd_changer_statut(promo, cmd->id_etu, DEMISSION);    break;
+	case CMD_DEFAILLANCE:  cmd_changer_statut(promo, cmd->id_etu, DEFAILLANCE);  break;
+	case CMD_JURY:         cmd_jury(promo, cmd->numero);                         break;
+	default:                                                                     break;
+	}
+
+	historique_valider(promo);
+	fin_modification(promo);
+	return 1;
+}
+
+/**
+ * @brief Exécute une commande si elle ne modifie pas la promotion.
+ *
+ * @param promo Pointeur vers la promotion.
+ * @param cmd Commande à exécuter.
+ * @return 1 si la commande est une requête (et a été exécutée), 0 sinon.
+ */
+int executer_requete(const t_promotion* promo, const t_commande* cmd) {
+	assert(promo != NULL && cmd != NULL);
+
+	switch (cmd->type) {
+	case CMD_CURSUS:       cmd_cursus(promo, cmd->id_etu, cmd->avec_version, cmd->version); break;
+	case CMD_ETUDIANTS:    cmd_etudiants(promo);                                        break;
+	case CMD_BILAN:        cmd_bilan(promo, cmd->numero);                               break;
+	case CMD_DISTRIBUTION: cmd_distribution(promo, cmd->periode);                       break;
+	case CMD_SIMULER_JURY: cmd_simuler_jury(promo, cmd->numero);                        break;
+	case CMD_VERSION:      cmd_version(promo);                                          break;
+	default:               return 0;
+	}
+
+	return 1;
+}
+
+/**
+ * @brief Écrit un texte formaté sur la sortie des commandes.
+ *
+ * Écrit directement sur stdout, dans le bloc courant du pipeline en
+ * mode batch, ou dans le tampon de capture d'un processus de rapport.
+ *
+ * @param format Format (comme printf).
+ */
+void ecrire(const char* format, ...) {
+	va_list args;
+	va_start(args, format);
+
+	if (capture_sortie != NULL) {
+		size_t reste = TAILLE_BLOC - capture_sortie->taille;
+		int lg = vsnprintf(capture_sortie->texte + capture_sortie->taille, reste, format, args);
+		assert(lg >= 0 && (size_t)lg < reste);
+		capture_sortie->taille += lg;
+	}
+#ifdef MODE_BATCH
+	else if (pipeline_sortie != NULL) {
+		pipeline_ecrire(pipeline_sortie, format, args);
+	}
+#endif
+	else {
+		vprintf(format, args);
+	}
+
+	va_end(args);
+}
+
+/**
+ * @brief Signale une erreur d'une commande de saisie.
+ *
+ * Affiche le message de l'erreur, ou en mode silencieux la compte avec
+ * la ligne de la commande en cours.
+ *
+ * @param erreur Erreur à signaler.
+ */
+void signaler_erreur(t_erreur erreur) {
+	assert(erreur >= 0 && erreur < NB_ERREURS);
+
+	if (!mode_silencieux.actif) {
+		ecrire("%s\n", LIBELLES_ERREURS[erreur]);
+		return;
+	}
+
+	int n = mode_silencieux.nb_erreurs[erreur]++;
+	if (n < MAX_LIGNES_ERREUR) {
+		mode_silencieux.lignes[erreur][n] = mode_silencieux.ligne;
+	}
+}
+
+/**
+ * @brief Affiche le résumé des erreurs comptées en mode silencieux.
+ *
+ * Affiche le nombre total d'erreurs puis, pour chaque type d'erreur
+ * rencontré, son nombre et ses premières lignes. N'affiche rien si le
+ * mode silencieux n'a pas été activé.
+ */
+void afficher_resume_erreurs(void) {
+	if (!mode_silencieux.actif) {
+		return;
+	}
+
+	int total = 0;
+	for (int err = 0; err < NB_ERREURS; err++) {
+		total += mode_silencieux.nb_erreurs[err];
+	}
+	ecrire("%d erreur(s)\n", total);
+
+	for (int err = 0; err < NB_ERREURS; err++) {
+		int n = mode_silencieux.nb_erreurs[err];
+		if (n == 0) {
+			continue;
+		}
+
+		ecrire("%s : %d (ligne%s", LIBELLES_ERREURS[err], n, (n > 1) ? "s" : "");
+		for (int i = 0; i < n && i < MAX_LIGNES_ERREUR; i++) {
+			ecrire("%s %d", (i == 0) ? "" : ",", mode_silencieux.lignes[err][i]);
+		}
+		ecrire("%s)\n", (n > MAX_LIGNES_ERREUR) ? ", ..." : "");
+	}
+}
+
+// ============================================================================
+// INITIALISATION
+// ============================================================================
+
+/**
+ * @brief Initialise la promotion avec des valeurs par défaut.
+ *
+ * Met à zéro le nombre d'inscrits et initialise toutes les notes à NOTE_INCONNUE.
+ * Initialise également le statut et le semestre des emplacements vides,
+ * ainsi qu'un historique, une liste d'étudiants actifs et un bilan des
+ * archives vides.
+ *
+ * @param promo Pointeur vers la structure de promotion à initialiser.
+ * @param num_formation Formation suivie par la promotion (FORMATION_BUT...).
+ */
+void init_promotion(t_promotion* promo, int num_formation) {
+	assert(promo != NULL && num_formation >= 0 && num_formation < NB_FORMATIONS);
+
+	promo->nb_inscrits = 0;
+	promo->num_formation = num_formation;
+
+	for (int i = 0; i < MAX_ETUDIANTS; i++) {
+		for (int sem = 0; sem < MAX_SEMESTRES; sem++) {
+			for (int ue = 0; ue < MAX_UE; ue++) {
+				promo->etudiants[i].notes[sem][ue] = NOTE_INCONNUE;
+			}
+		}
+		promo->etudiants[i].statut = EN_COURS;
+		promo->etudiants[i].semestre_actuel = 1;
+
+		promo->historique.dernier_evenement[i] = -1;
+		promo->historique.dernier_point[i] = -1;
+		promo->historique.nb_evenements_etu[i] = 0;
+		promo->revisions[i] = 0;
+	}
+
+	promo->historique.nb_evenements = 0;
+	promo->historique.nb_versions = 0;
+	promo->historique.fin_versions[0] = 0;
+	promo->historique.plein = 0;
+	promo->historique.nb_points = 0;
+
+	promo->nb_actifs = 0;
+	for (int an = 0; an < MAX_ANNEES; an++) {
+		for (int cat = 0; cat < NB_CATEGORIES_BILAN; cat++) {
+			promo->bilan_archives[an][cat] = 0;
+		}
+	}
+
+#ifdef PROMOTION_PARTAGEE
+	atomic_init(&promo->generation, 0);
+#else
+	promo->generation = 0;
+#endif
+}
+
+// ============================================================================
+// SPRINT 1 - Commandes de base
+// ============================================================================
+
+// --- INSCRIRE ---
+/**
+ * @brief Inscrit un nouvel étudiant dans la promotion.
+ *
+ * Vérifie si l'étudiant existe déjà (doublon).
+ * Si la promotion n'est pas pleine, ajoute l'étudiant.
+ *
+ * @param promo Pointeur vers la promotion.
+ * @param prenom_saisi Prénom de l'étudiant.
+ * @param nom_saisi Nom de l'étudiant.
+ */
+void cmd_inscrire(t_promotion* promo, const char* prenom_saisi, const char* nom_saisi) {
+	assert(promo != NULL && prenom_saisi != NULL && nom_saisi != NULL);
+
+	int doublon = 0;
+
+	// Vérifier si l'étudiant existe déjà
+	for (int i = 0; i < promo->nb_inscrits; i++) {
+		if (strcmp(promo->etudiants[i].nom, nom_saisi) == 0 &&
+			strcmp(promo->etudiants[i].prenom, prenom_saisi) == 0) {
+			doublon = 1;
+			break;
+		}
+	}
+
+	if (doublon) {
+		signaler_erreur(ERR_NOM);
+	}
+	else {
+		if (promo->nb_inscrits < MAX_ETUDIANTS) {
+			int pos = promo->nb_inscrits;
+
+			strcpy(promo->etudiants[pos].nom, nom_saisi);
+			strcpy(promo->etudiants[pos].prenom, prenom_saisi);
+			promo->etudiants[pos].statut = EN_COURS;
+			promo->etudiants[pos].semestre_actuel = 1;
+
+			promo->nb_inscrits++;
+			promo->actifs[promo->nb_actifs++] = pos;
+			historique_enregistrer(promo, pos, EVT_INSCRIPTION, 0, 0, 0.0f);
+			if (!mode_silencieux.actif) {
+				ecrire("Inscription enregistree (%d)\n", promo->nb_inscrits);
+			}
+		}
+	}
+}
+
+// --- NOTE ---
+/**
+ * @brief Enregistre ou modifie la note d'un étudiant.
+ *
+ * Effectue des vérifications (ID valide, étudiant en cours, UE valide, note valide).
+ * Enregistre la note pour le semestre actuel de l'étudiant.
+ *
+ * @param promo Pointeur vers la promotion.
+ * @param id_etu Identifiant de l'étudiant.
+ * @param num_ue Numéro de l'UE (1 au nombre d'UE de la formation).
+ * @param note Note saisie.
+ */
+void cmd_note(t_promotion* promo, int id_etu, int num_ue, float note) {
+	assert(promo != NULL);
+
+	// Validation de l'ID
+	if (id_etu <= 0 || id_etu > promo->nb_inscrits) {
+		signaler_erreur(ERR_IDENTIFIANT);
+		return;
+	}
+
+	int idx = id_etu - 1;
+
+	// Vérifier que l'étudiant est EN_COURS
+	if (promo->etudiants[idx].statut != EN_COURS) {
+		signaler_erreur(ERR_HORS_FORMATION);
+		return;
+	}
+
+	// Validation du numéro d'UE
+	if (num_ue < 1 || num_ue > FORMATIONS[promo->num_formation].nb_ue) {
+		signaler_erreur(ERR_UE);
+		return;
+	}
+
+	// Validation de la note
+	if (!(note >= 0.0f && note <= MAX_NOTE)) { // Refuse aussi NaN
+		signaler_erreur(ERR_NOTE);
+		return;
+	}
+
+	// Enregistrer la note au semestre actuel
+	int idx_ue = num_ue - 1;
+	int sem_actuel = promo->etudiants[idx].semestre_actuel;
+	int idx_sem = sem_actuel - 1;
+
+	promo->etudiants[idx].notes[idx_sem][idx_ue] = note;
+	historique_enregistrer(promo, idx, EVT_NOTE, idx_sem, idx_ue, note);
+	marquer_cursus_modifie(promo, idx);
+	if (!mode_silencieux.actif) {
+		ecrire("Note enregistree\n");
+	}
+}
+
+// --- NOTES ---
+/**
+ * @brief Enregistre toutes les notes du semestre actuel d'un étudiant.
+ *
+ * L'ID et le statut sont vérifiés une seule fois, puis les bornes des
+ * MAX_UE notes en une seule boucle sans branchement. Les notes ne sont
+ * enregistrées que si toutes sont valides ; les UE à NOTE_INCONNUE (*)
+ * ne sont pas modifiées.
+ *
+ * @param promo Pointeur vers la promotion.
+ * @param id_etu Identifiant de l'étudiant.
+ * @param notes Notes de chaque UE (NOTE_INCONNUE pour ne pas la modifier).
+ */
+void cmd_notes(t_promotion* promo, int id_etu, const float notes[MAX_UE]) {
+	assert(promo != NULL && notes != NULL);
+
+	if (id_etu <= 0 || id_etu > promo->nb_inscrits) {
+		signaler_erreur(ERR_IDENTIFIANT);
+		return;
+	}
+
+	int idx = id_etu - 1;
+	t_etudiant* etu = &promo->etudiants[idx];
+
+	if (etu->statut != EN_COURS) {
+		signaler_erreur(ERR_HORS_FORMATION);
+		return;
+	}
+
+	int invalide = 0;
+	for (int ue = 0; ue < MAX_UE; ue++) {
+		invalide |= (notes[ue] != NOTE_INCONNUE) & !((notes[ue] >= 0.0f) & (notes[ue] <= MAX_NOTE)); // NaN compris
+	}
+
+	if (invalide) {
+		signaler_erreur(ERR_NOTE);
+		return;
+	}
+
+	int idx_sem = etu->semestre_actuel - 1;
+
+	for (int ue = 0; ue < MAX_UE; ue++) {
+		if (notes[ue] != NOTE_INCONNUE) {
+			etu->notes[idx_sem][ue] = notes[ue];
+			historique_enregistrer(promo, idx, EVT_NOTE, idx_sem, ue, notes[ue]);
+		}
+	}
+	marquer_cursus_modifie(promo, idx);
+
+	if (!mode_silencieux.actif) {
+		ecrire("Notes enregistrees\n");
+	}
+}
+
+// --- Fonctions de calcul ---
+
+/**
+ * @brief Calcule la moyenne annuelle (RCUE) pour une UE.
+ *
+ * Moyenne des notes d'une même UE sur les deux semestres de l'année.
+ *
+ * @param etu Pointeur vers l'étudiant.
+ * @param annee Année concernée (1 à MAX_ANNEES).
+ * @param num_ue Index de l'UE (0 à MAX_UE-1).
+ * @return La moyenne sur 20, ou NOTE_INCONNUE si une des notes manque.
+ */
+float calculer_moyenne_annee(const t_etudiant* etu, int annee, int num_ue) {
+	assert(etu != NULL && annee >= 1 && annee <= MAX_ANNEES && num_ue >= 0 && num_ue < MAX_UE);
+
+	int sem1 = (annee - 1) * 2;
+	int sem2 = (annee - 1) * 2 + 1;
+
+	float note1 = etu->notes[sem1][num_ue];
+	float note2 = etu->notes[sem2][num_ue];
 
 	if (note1 == NOTE_INCONNUE || note2 == NOTE_INCONNUE) {
 		return NOTE_INCONNUE;
@@ -325,6 +1334,68 @@ float calculer_moyenne_annee(const t_etudiant* etu, int annee, int num_ue) {
 	return (note1 + note2) / 2.0f;
 }
 
+/**
+ * @brief Indique si le jury de fin d'une année a déjà été fait pour un étudiant.
+ *
+ * Déduit de l'avancement dans les semestres : le jury est fait si l'étudiant
+ * a dépassé le semestre pair de l'année, ou s'il y est resté avec une décision.
+ *
+ * @param etu Pointeur vers l'étudiant.
+ * @param annee Année concernée (1, 2 ou 3).
+ * @return 1 si le jury de l'année a été fait, 0 sinon.
+ */
+int jury_annee_fait(const t_etudiant* etu, int annee) {
+	assert(etu != NULL && annee >= 1 && annee <= MAX_ANNEES);
+
+	int sem_fin_annee = annee * 2;
+	return (etu->semestre_actuel > sem_fin_annee) ||
+		(etu->semestre_actuel == sem_fin_annee && etu->statut != EN_COURS);
+}
+
+/**
+ * @brief Détermine le code de validation d'une note d'UE semestrielle.
+ *
+ * @param note Note du semestre (connue).
+ * @param moy_annee Moyenne annuelle correspondante (RCUE).
+ * @param moy_suivante Moyenne de l'année suivante.
+ * @param seuil_validation Note minimale pour valider une UE.
+ * @return CODE_ADM, CODE_ADC, CODE_ADS ou CODE_AJ.
+ */
+t_code code_note(float note, float moy_annee, float moy_suivante, float seuil_validation) {
+	if (note >= seuil_validation) {
+		return CODE_ADM;
+	}
+	if (moy_annee != NOTE_INCONNUE && moy_annee >= seuil_validation) {
+		return CODE_ADC;  // Compensation par RCUE
+	}
+	if (moy_suivante != NOTE_INCONNUE && moy_suivante >= seuil_validation) {
+		return CODE_ADS;  // Compensé par année suivante
+	}
+	return CODE_AJ;
+}
+
+/**
+ * @brief Détermine le code de validation d'une moyenne annuelle.
+ *
+ * @param moy_annee Moyenne de l'année concernée (connue).
+ * @param moy_suivante Moyenne de l'année suivante (pour compensation).
+ * @param seuil_validation Note minimale pour valider une UE.
+ * @param seuil_bloquant Moyenne en dessous de laquelle l'UE est bloquante.
+ * @return CODE_ADM, CODE_ADS, CODE_AJB ou CODE_AJ.
+ */
+t_code code_moyenne(float moy_annee, float moy_suivante, float seuil_validation, float seuil_bloquant) {
+	if (moy_annee >= seuil_validation) {
+		return CODE_ADM;
+	}
+	if (moy_suivante != NOTE_INCONNUE && moy_suivante >= seuil_validation) {
+		return CODE_ADS;  // Compensé par année suivante
+	}
+	if (moy_annee < seuil_bloquant) {
+		return CODE_AJB;
+	}
+	return CODE_AJ;
+}
+
 // --- Fonctions d'affichage ---
 
 /**
@@ -338,27 +1409,18 @@ float calculer_moyenne_annee(const t_etudiant* etu, int annee, int num_ue) {
  *
  * @param moy_annee Moyenne de l'année concernée.
  * @param moy_suivante Moyenne de l'année suivante (pour compensation).
+ * @param seuil_validation Note minimale pour valider une UE.
+ * @param seuil_bloquant Moyenne en dessous de laquelle l'UE est bloquante.
  */
-void afficher_moyenne_avec_code(float moy_annee, float moy_suivante) {
+void afficher_moyenne_avec_code(float moy_annee, float moy_suivante, float seuil_validation, float seuil_bloquant) {
 	if (moy_annee == NOTE_INCONNUE) {
-		printf("* (*)");
+		ecrire("* (*)");
 		return;
 	}
 
 	float moy_tronquee = floorf(moy_annee * 10.0f) / 10.0f;
 
-	if (moy_annee >= SEUIL_VALIDATION) {
-		printf("%.1f (ADM)", moy_tronquee);
-	}
-	else if (moy_suivante != NOTE_INCONNUE && moy_suivante >= SEUIL_VALIDATION) {
-		printf("%.1f (ADS)", moy_tronquee);  // Compensé par année suivante
-	}
-	else if (moy_annee < SEUIL_BLOQUANT) {
-		printf("%.1f (AJB)", moy_tronquee);
-	}
-	else {
-		printf("%.1f (AJ)", moy_tronquee);
-	}
+	ecrire("%.1f (%s)", moy_tronquee, LIBELLES_CODES[code_moyenne(moy_annee, moy_suivante, seuil_validation, seuil_bloquant)]);
 }
 
 /**
@@ -373,27 +1435,17 @@ void afficher_moyenne_avec_code(float moy_annee, float moy_suivante) {
  * @param note Note du semestre.
  * @param moy_annee Moyenne annuelle correspondante (RCUE).
  * @param moy_suivante Moyenne de l'année suivante.
+ * @param seuil_validation Note minimale pour valider une UE.
  */
-void afficher_note_avec_code(float note, float moy_annee, float moy_suivante) {
+void afficher_note_avec_code(float note, float moy_annee, float moy_suivante, float seuil_validation) {
 	if (note == NOTE_INCONNUE) {
-		printf("* (*)");
+		ecrire("* (*)");
 		return;
 	}
 
 	float note_tronquee = floorf(note * 10.0f) / 10.0f;
 
-	if (note >= SEUIL_VALIDATION) {
-		printf("%.1f (ADM)", note_tronquee);
-	}
-	else if (moy_annee != NOTE_INCONNUE && moy_annee >= SEUIL_VALIDATION) {
-		printf("%.1f (ADC)", note_tronquee);  // Compensation par RCUE
-	}
-	else if (moy_suivante != NOTE_INCONNUE && moy_suivante >= SEUIL_VALIDATION) {
-		printf("%.1f (ADS)", note_tronquee);  // Compensé par année suivante
-	}
-	else {
-		printf("%.1f (AJ)", note_tronquee);
-	}
+	ecrire("%.1f (%s)", note_tronquee, LIBELLES_CODES[code_note(note, moy_annee, moy_suivante, seuil_validation)]);
 }
 
 /**
@@ -403,481 +1455,1653 @@ void afficher_note_avec_code(float note, float moy_annee, float moy_suivante) {
  */
 void afficher_statut(t_statut statut) {
 	switch (statut) {
-	case EN_COURS:    printf("en cours");    break;
-	case DEMISSION:   printf("demission");   break;
-	case DEFAILLANCE: printf("defaillance"); break;
-	case AJOURNE:     printf("ajourne");     break;
-	case DIPLOME:     printf("diplome");     break;
-	default:          printf("statut_inconnu"); break;
+	case EN_COURS:    ecrire("en cours");    break;
+	case DEMISSION:   ecrire("demission");   break;
+	case DEFAILLANCE: ecrire("defaillance"); break;
+	case AJOURNE:     ecrire("ajourne");     break;
+	case DIPLOME:     ecrire("diplome");     break;
+	default:          ecrire("statut_inconnu"); break;
 	}
 }
 
 // --- CURSUS ---
 /**
- * @brief Affiche le parcours complet d'un étudiant.
+ * @brief Affiche le parcours d'un étudiant, actuel ou à une version passée.
  *
- * Affiche l'historique des semestres (S1 à S6) avec les notes,
- * les moyennes annuelles (B1, B2, B3) et les statuts.
- * Gère l'affichage des compensations (ADC, ADS) selon l'avancement
- * dans le cursus et les décisions de jury.
+ * Sans version, affiche l'état actuel (depuis le cache des cursus) ;
+ * sinon, l'état reconstruit depuis l'historique. Une fois l'historique
+ * plein, les versions postérieures à la dernière enregistrée sont refusées.
  *
  * @param promo Pointeur vers la promotion.
+ * @param id_etu Identifiant de l'étudiant.
+ * @param avec_version 1 si une version est précisée.
+ * @param version Version demandée.
  */
-void cmd_cursus(const t_promotion* promo) {
+void cmd_cursus(const t_promotion* promo, int id_etu, int avec_version, int version) {
 	assert(promo != NULL);
 
-	int id_etu;
-	scanf("%d", &id_etu);
+	const t_historique* hist = &promo->historique;
 
 	if (id_etu <= 0 || id_etu > promo->nb_inscrits) {
-		printf("Identifiant incorrect\n");
+		ecrire("Identifiant incorrect\n");
 		return;
 	}
 
-	int idx = id_etu - 1;
-	const t_etudiant* etu = &promo->etudiants[idx];
+	if (avec_version && (version < 0 || version > hist->nb_versions)) {
+		ecrire("Version incorrecte\n");
+		return;
+	}
+
+	int idx = id_etu - 1;
+
+	// La dernière version n'est l'état actuel que si l'historique n'a rien perdu
+	if (!avec_version || (version == hist->nb_versions && !hist->plein)) {
+		afficher_cursus_cache(promo, idx);
+		return;
+	}
+
+	t_etudiant etat;
+	if (!reconstruire_etudiant(promo, idx, hist->fin_versions[version], &etat)) {
+		ecrire("Identifiant incorrect\n");  // Pas encore inscrit à cette version
+		return;
+	}
+	FORMATIONS[promo->num_formation].afficher_cursus(id_etu, &etat);
+}
+
+/**
+ * @brief Affiche le parcours complet d'un étudiant.
+ *
+ * Affiche l'historique des semestres (S1 à S6 en BUT) avec les notes,
+ * les moyennes annuelles (B1, B2, B3) et les statuts.
+ * Gère l'affichage des compensations (ADC, ADS) selon l'avancement
+ * dans le cursus et les décisions de jury.
+ * Corps générique : appelé par FORMATIONS[...].afficher_cursus, avec les
+ * constantes de la formation (voir DEFINIR_FORMATION).
+ *
+ * @param id_etu Identifiant de l'étudiant.
+ * @param etu Pointeur vers l'étudiant.
+ * @param nb_annees Nombre d'années de la formation.
+ * @param nb_ue Nombre d'UE par semestre.
+ * @param seuil_validation Note minimale pour valider une UE.
+ * @param seuil_bloquant Moyenne en dessous de laquelle l'UE est bloquante.
+ */
+SPECIALISE void afficher_cursus(int id_etu, const t_etudiant* etu, int nb_annees, int nb_ue,
+	float seuil_validation, float seuil_bloquant) {
+	assert(etu != NULL && nb_annees <= MAX_ANNEES && nb_ue <= MAX_UE);
 
-	printf("%d %s %s\n", id_etu, etu->prenom, etu->nom);
+	ecrire("%d %s %s\n", id_etu, etu->prenom, etu->nom);
 
 	// Calculer toutes les moyennes annuelles
-	float moyennes_annee[NB_ANNEES][NB_UE];
-	int jury_fait[NB_ANNEES];
+	float moyennes_annee[MAX_ANNEES][MAX_UE];
+	int jury_fait[MAX_ANNEES];
 
-	for (int an = 0; an < NB_ANNEES; an++) {
+	for (int an = 0; an < nb_annees; an++) {
 		int annee = an + 1;
-		for (int ue = 0; ue < NB_UE; ue++) {
+		for (int ue = 0; ue < nb_ue; ue++) {
 			moyennes_annee[an][ue] = calculer_moyenne_annee(etu, annee, ue);
 		}
 
 		// Déterminer si le jury de l'année 'annee' a été fait
-		// Conditions approximatives basées sur l'avancement dans les semestres
-		int sem_fin_annee = annee * 2;
-		jury_fait[an] = (etu->semestre_actuel > sem_fin_annee) ||
-			(etu->semestre_actuel == sem_fin_annee && etu->statut != EN_COURS);
+		jury_fait[an] = jury_annee_fait(etu, annee);
 	}
 
 	// Boucle sur les années
-	for (int an = 0; an < NB_ANNEES; an++) {
+	for (int an = 0; an < nb_annees; an++) {
 		int annee = an + 1;
 		int sem_impair = (annee - 1) * 2 + 1;
 		int sem_pair = annee * 2;
 
 		// Semestre impair (S1, S3, S5...)
 		if (etu->semestre_actuel >= sem_impair) {
-			printf("S%d", sem_impair);
-			for (int ue = 0; ue < NB_UE; ue++) {
-				printf(" - ");
+			ecrire("S%d", sem_impair);
+			for (int ue = 0; ue < nb_ue; ue++) {
+				ecrire(" - ");
+				float moy_compens = jury_fait[an] ? moyennes_annee[an][ue] : NOTE_INCONNUE;
+				float moy_suiv = (an < nb_annees - 1 && jury_fait[an + 1]) ? moyennes_annee[an + 1][ue] : NOTE_INCONNUE;
+				
+				// Dernière année : pas de compensation année suivante
+				if (annee == nb_annees) moy_suiv = NOTE_INCONNUE;
+
+				afficher_note_avec_code(etu->notes[sem_impair - 1][ue], moy_compens, moy_suiv, seuil_validation);
+			}
+			ecrire(" -");
+			if (etu->semestre_actuel == sem_impair) {
+				ecrire(" ");
+				afficher_statut(etu->statut);
+			}
+			ecrire("\n");
+		}
+
+		// Semestre pair (S2, S4, S6...)
+		if (etu->semestre_actuel >= sem_pair) {
+			ecrire("S%d", sem_pair);
+			for (int ue = 0; ue < nb_ue; ue++) {
+				ecrire(" - ");
 				float moy_compens = jury_fait[an] ? moyennes_annee[an][ue] : NOTE_INCONNUE;
-				float moy_suiv = (an < NB_ANNEES - 1 && jury_fait[an + 1]) ? moyennes_annee[an + 1][ue] : NOTE_INCONNUE;
+				float moy_suiv = (an < nb_annees - 1 && jury_fait[an + 1]) ? moyennes_annee[an + 1][ue] : NOTE_INCONNUE;
+
+				// Dernière année : pas de compensation année suivante
+				if (annee == nb_annees) moy_suiv = NOTE_INCONNUE;
+
+				afficher_note_avec_code(etu->notes[sem_pair - 1][ue], moy_compens, moy_suiv, seuil_validation);
+			}
+			ecrire(" -");
+			if (etu->semestre_actuel == sem_pair && etu->statut != AJOURNE && etu->statut != DIPLOME) {
+				ecrire(" ");
+				afficher_statut(etu->statut);
+			}
+			ecrire("\n");
+		}
+
+		// Bilan Annuel (B1, B2, B3...)
+		if (jury_fait[an] || (etu->semestre_actuel == sem_pair && etu->statut == AJOURNE)) {
+			ecrire("B%d", annee);
+			for (int ue = 0; ue < nb_ue; ue++) {
+				ecrire(" - ");
+				float moy_suiv = (an < nb_annees - 1 && jury_fait[an + 1]) ? moyennes_annee[an + 1][ue] : NOTE_INCONNUE;
 				
-				// Pour S5 (dernière année), pas de compensation année suivante
-				if (annee == NB_ANNEES) moy_suiv = NOTE_INCONNUE;
+				// Dernière année : pas de compensation suivante
+				if (annee == nb_annees) moy_suiv = NOTE_INCONNUE;
+
+				afficher_moyenne_avec_code(moyennes_annee[an][ue], moy_suiv, seuil_validation, seuil_bloquant);
+			}
+			ecrire(" -");
+			if (etu->semestre_actuel == sem_pair && etu->statut == AJOURNE) {
+				ecrire(" ajourne");
+			} else if (annee == nb_annees && etu->statut == DIPLOME) {
+				ecrire(" ");
+				afficher_statut(etu->statut);
+			}
+			ecrire("\n");
+		}
+	}
+}
+
+// --- ETUDIANTS ---
+/**
+ * @brief Affiche la liste de tous les étudiants de la promotion.
+ *
+ * Affiche l'ID, le nom, le prénom, le semestre actuel et le statut.
+ *
+ * @param promo Pointeur vers la promotion.
+ */
+void cmd_etudiants(const t_promotion* promo) {
+	assert(promo != NULL);
+
+	for (int i = 0; i < promo->nb_inscrits; i++) {
+		const t_etudiant* etu = &promo->etudiants[i];
+		int id = i + 1;
+
+		ecrire("%d - %s %s - S%d - ", id, etu->prenom, etu->nom, etu->semestre_actuel);
+		afficher_statut(etu->statut);
+		ecrire("\n");
+	}
+}
+
+// ============================================================================
+// SPRINT 2 - DEMISSION, DEFAILLANCE, JURY (semestres impairs)
+// ============================================================================
+
+// --- DEMISSION / DEFAILLANCE ---
+/**
+ * @brief Change le statut d'un étudiant (Démission ou Défaillance).
+ *
+ * Vérifie l'ID et si l'étudiant est EN_COURS.
+ * Modifie le statut selon le paramètre nouveau_statut.
+ *
+ * @param promo Pointeur vers la promotion.
+ * @param id_etu Identifiant de l'étudiant.
+ * @param nouveau_statut Nouveau statut à appliquer (DEMISSION ou DEFAILLANCE).
+ */
+void cmd_changer_statut(t_promotion* promo, int id_etu, t_statut nouveau_statut) {
+	assert(promo != NULL);
+
+	if (id_etu <= 0 || id_etu > promo->nb_inscrits) {
+		signaler_erreur(ERR_IDENTIFIANT);
+		return;
+	}
+
+	int idx = id_etu - 1;
+
+	if (promo->etudiants[idx].statut != EN_COURS) {
+		signaler_erreur(ERR_HORS_FORMATION);
+		return;
+	}
+
+	promo->etudiants[idx].statut = nouveau_statut;
+	historique_enregistrer(promo, idx, EVT_STATUT, 0, 0, (float)nouveau_statut);
+	marquer_cursus_modifie(promo, idx);
+	archiver_termines(promo);
+
+	if (mode_silencieux.actif) {
+		return;
+	}
+
+	if (nouveau_statut == DEMISSION) {
+		ecrire("Demission enregistree\n");
+	}
+	else {
+		ecrire("Defaillance enregistree\n");
+	}
+}
+
+// --- Fonctions auxiliaires pour JURY ---
+
+/**
+ * @brief Vérifie si toutes les notes sont saisies pour un semestre donné.
+ *
+ * Pour les jurys pairs (fin d'année), on vérifie le semestre pair courant.
+ * (Il est impossible d'être en semestre pair sans avoir validé le précédent).
+ * Pour les jurys impairs, vérifie uniquement le semestre courant.
+ *
+ * @param promo Pointeur vers la promotion.
+ * @param num_sem Numéro du semestre à vérifier.
+ * @return 1 si des notes sont manquantes, 0 sinon.
+ */
+int verif_notes_incompletes(const t_promotion* promo, int num_sem) {
+	assert(promo != NULL);
+
+	const t_formation* formation = &FORMATIONS[promo->num_formation];
+	int idx_sem = num_sem - 1;
+
+	for (int a = 0; a < promo->nb_actifs; a++) {
+		int i = promo->actifs[a];
+
+		if (promo->etudiants[i].semestre_actuel != num_sem) {
+			continue;
+		}
+
+		if (!formation->semestre_complet(&promo->etudiants[i], idx_sem)) {
+			return 1;
+		}
+	}
+
+	return 0;
+}
+
+/**
+ * @brief Indique si toutes les notes d'un semestre d'un étudiant sont saisies.
+ *
+ * Corps générique : appelé par FORMATIONS[...].semestre_complet, avec le
+ * nombre d'UE de la formation comme constante (voir DEFINIR_FORMATION). La boucle
+ * ne s'interrompt pas pour rester vectorisable.
+ *
+ * @param etu Pointeur vers l'étudiant.
+ * @param idx_sem Index du semestre (0 à MAX_SEMESTRES-1).
+ * @param nb_ue Nombre d'UE par semestre.
+ * @return 1 si aucune note ne manque, 0 sinon.
+ */
+SPECIALISE int semestre_complet(const t_etudiant* etu, int idx_sem, int nb_ue) {
+	assert(etu != NULL && idx_sem >= 0 && idx_sem < MAX_SEMESTRES && nb_ue <= MAX_UE);
+
+	int manquantes = 0;
+	for (int ue = 0; ue < nb_ue; ue++) {
+		manquantes |= (etu->notes[idx_sem][ue] == NOTE_INCONNUE);
+	}
+	return !manquantes;
+}
+
+/**
+ * @brief Fait passer les étudiants au semestre suivant (pour les jurys impairs).
+ *
+ * @param promo Pointeur vers la promotion.
+ * @param num_sem Numéro du semestre actuel.
+ * @return Le nombre d'étudiants ayant changé de semestre.
+ */
+int passer_semestre_suivant(t_promotion* promo, int num_sem) {
+	assert(promo != NULL);
+
+	// Vérifie que le semestre est bien impair
+	if (num_sem % 2 == 0) {
+		return 0;
+	}
+
+	int compteur = 0;
+	for (int a = 0; a < promo->nb_actifs; a++) {
+		int i = promo->actifs[a];
+
+		if (promo->etudiants[i].semestre_actuel == num_sem) {
+
+			promo->etudiants[i].semestre_actuel++;
+			historique_enregistrer(promo, i, EVT_SEMESTRE, 0, 0, (float)promo->etudiants[i].semestre_actuel);
+			marquer_cursus_modifie(promo, i);
+			compteur++;
+		}
+	}
+	return compteur;
+}
+
+/**
+ * @brief Retire de la liste des actifs les étudiants sortis de formation.
+ *
+ * Leur part du bilan de chaque année est ajoutée à bilan_archives :
+ * leur statut ne changeant plus, elle n'est jamais recalculée.
+ * L'ordre des étudiants restants est conservé.
+ *
+ * @param promo Pointeur vers la promotion.
+ */
+void archiver_termines(t_promotion* promo) {
+	assert(promo != NULL);
+
+	int nb_annees = FORMATIONS[promo->num_formation].nb_annees;
+	int nb_restants = 0;
+
+	for (int a = 0; a < promo->nb_actifs; a++) {
+		int i = promo->actifs[a];
+		const t_etudiant* etu = &promo->etudiants[i];
+
+		if (etu->statut == EN_COURS) {
+			promo->actifs[nb_restants++] = i;
+			continue;
+		}
+
+		for (int an = 0; an < nb_annees; an++) {
+			promo->bilan_archives[an][categorie_bilan(etu, an + 1, nb_annees)]++;
+		}
+	}
+
+	promo->nb_actifs = nb_restants;
+}
+
+// --- JURY ---
+/**
+ * @brief Gère les jurys de fin de semestre.
+ *
+ * Vérifie que toutes les notes sont présentes.
+ * Si semestre impair : passage automatique au suivant.
+ * Si semestre pair : appel du jury de fin d'année de la formation (jury_fin_annee).
+ *
+ * @param promo Pointeur vers la promotion.
+ * @param num_sem Numéro du semestre.
+ */
+void cmd_jury(t_promotion* promo, int num_sem) {
+	assert(promo != NULL);
+
+	const t_formation* formation = &FORMATIONS[promo->num_formation];
+
+	if (num_sem < 1 || num_sem > formation->nb_semestres) {
+		ecrire("Semestre incorrect\n");
+		return;
+	}
+
+	if (verif_notes_incompletes(promo, num_sem)) {
+		ecrire("Des notes sont manquantes\n");
+		return;
+	}
+
+	int nb_etu_traites = 0;
+
+	if (num_sem % 2 != 0) {
+		// SEMESTRES IMPAIRS : Passage automatique
+		nb_etu_traites = passer_semestre_suivant(promo, num_sem);
+	}
+	else {
+		// SEMESTRES PAIRS : Application des règles
+		for (int a = 0; a < promo->nb_actifs; a++) {
+			int i = promo->actifs[a];
+
+			if (promo->etudiants[i].semestre_actuel == num_sem) {
+				t_etudiant* etu = &promo->etudiants[i];
+
+				nb_etu_traites++;
+				formation->jury_fin_annee(etu, num_sem / 2);
+				marquer_cursus_modifie(promo, i);
+
+				// Le jury fait passer à l'année suivante ou change le statut
+				if (etu->statut == EN_COURS) {
+					historique_enregistrer(promo, i, EVT_SEMESTRE, 0, 0, (float)etu->semestre_actuel);
+				}
+				else {
+					historique_enregistrer(promo, i, EVT_STATUT, 0, 0, (float)etu->statut);
+				}
+			}
+		}
+
+		archiver_termines(promo);
+	}
+
+	ecrire("Semestre termine pour %d etudiant(s)\n", nb_etu_traites);
+}
+
+// ============================================================================
+// SPRINT 3 - JURY (semestres pairs)
+// ============================================================================
+
+/**
+ * @brief Applique les règles de validation d'une année.
+ *
+ * Cette fonction générique gère tous les jurys de fin d'année (1, 2, 3...).
+ * Elle est appelée par FORMATIONS[...].jury_fin_annee, avec les constantes
+ * de la formation (voir DEFINIR_FORMATION).
+ *
+ * Règles générales :
+ * 1. Pour l'année courante :
+ *    - Années intermédiaires : Avoir validé au moins min_rcue_valides UE et aucun blocage.
+ *    - Année finale : Avoir validé toutes les UE.
+ * 2. Pour les années précédentes (si annee > 1) :
+ *    - Avoir validé toutes les UE de l'année précédente (via compensation si nécessaire).
+ *
+ * @param etu Pointeur vers l'étudiant.
+ * @param annee Année à valider (1, 2, 3...).
+ * @param nb_annees Nombre d'années de la formation.
+ * @param nb_ue Nombre d'UE par semestre.
+ * @param min_rcue_valides UE à valider pour passer à l'année suivante.
+ * @param seuil_validation Note minimale pour valider une UE.
+ * @param seuil_bloquant Moyenne en dessous de laquelle l'UE est bloquante.
+ */
+SPECIALISE void jury_fin_annee(t_etudiant* etu, int annee, int nb_annees, int nb_ue, int min_rcue_valides,
+	float seuil_validation, float seuil_bloquant) {
+	assert(etu != NULL && annee >= 1 && annee <= nb_annees && nb_annees <= MAX_ANNEES && nb_ue <= MAX_UE);
+
+	float moy_annee[MAX_UE];
+	float moy_prec[MAX_UE]; // Pour stocker les moyennes de l'année précédente si besoin
+
+	int nb_valides = 0;
+	int a_rcue_bloquant = 0;
+	int annees_prec_ok = 1;
+
+	// Vérification de l'année précédente (si elle existe)
+	if (annee > 1) {
+		for (int ue = 0; ue < nb_ue; ue++) {
+			moy_prec[ue] = calculer_moyenne_annee(etu, annee - 1, ue);
+			moy_annee[ue] = calculer_moyenne_annee(etu, annee, ue); // On en a besoin pour vérifier la compensation
+
+			// L'UE de l'année précédente est validée si :
+			// - Sa moyenne est >= seuil_validation
+			// - OU si elle est compensée par l'UE correspondante de l'année courante (moy_annee >= seuil_validation)
+			// Note: Dans le code original jury_fin_annee2/3, la condition était :
+			// if (moy_b1[ue] < 10 && moy_b2[ue] < 10) alors KO.
+			// Ce qui revient à dire : OK si moy_b1 >= 10 OU moy_b2 >= 10.
+			if (moy_prec[ue] < seuil_validation && moy_annee[ue] < seuil_validation) {
+				annees_prec_ok = 0;
+			}
+		}
+	}
+	else {
+		// Pour la première année, il suffit de calculer ses moyennes
+		for (int ue = 0; ue < nb_ue; ue++) {
+			moy_annee[ue] = calculer_moyenne_annee(etu, annee, ue);
+		}
+	}
+
+	// Analyse de l'année courante
+	for (int ue = 0; ue < nb_ue; ue++) {
+		if (moy_annee[ue] >= seuil_validation) {
+			nb_valides++;
+		}
+		if (moy_annee[ue] < seuil_bloquant) {
+			a_rcue_bloquant = 1;
+		}
+	}
+
+	// Application de la décision
+	int admis = 0;
+
+	if (annee < nb_annees) {
+		// Année intermédiaire : Passage si conditions respectées
+		if (nb_valides >= min_rcue_valides && a_rcue_bloquant == 0 && annees_prec_ok) {
+			admis = 1;
+		}
+	}
+	else {
+		// Année finale (Diplôme) : Toutes les UE doivent être validées
+		if (nb_valides == nb_ue && annees_prec_ok) {
+			admis = 1;
+		}
+	}
+
+	if (admis) {
+		if (annee < nb_annees) {
+			etu->semestre_actuel++; // Passage au S3, S5...
+		}
+		else {
+			etu->statut = DIPLOME;
+		}
+	}
+	else {
+		etu->statut = AJOURNE;
+	}
+}
+
+// ============================================================================
+// SPRINT 4 - BILAN
+// ============================================================================
+
+/**
+ * @brief Détermine la catégorie dans laquelle un étudiant compte pour le bilan d'une année.
+ *
+ * @param etu Pointeur vers l'étudiant.
+ * @param annee Année du bilan (1 à nb_annees).
+ * @param nb_annees Nombre d'années de la formation.
+ * @return La catégorie, ou BILAN_AUCUNE si l'étudiant ne compte pas pour cette année.
+ */
+t_categorie_bilan categorie_bilan(const t_etudiant* etu, int annee, int nb_annees) {
+	assert(etu != NULL && annee >= 1 && annee <= nb_annees);
+
+	int sem_debut = (annee - 1) * 2 + 1;
+	int sem_fin = annee * 2;
+
+	// Ignorer les étudiants qui n'ont pas atteint cette année
+	if (etu->semestre_actuel < sem_debut) {
+		return BILAN_AUCUNE;
+	}
+
+	// CAS 1 : étudiant au semestre impair de l'année
+	if (etu->semestre_actuel == sem_debut) {
+		if (etu->statut == DEMISSION) {
+			return BILAN_DEMISSION;
+		}
+		else if (etu->statut == DEFAILLANCE) {
+			return BILAN_DEFAILLANCE;
+		}
+		else if (etu->statut == EN_COURS) {
+			return BILAN_EN_COURS;
+		}
+	}
+	// CAS 2 : étudiant au semestre pair de l'année
+	else if (etu->semestre_actuel == sem_fin) {
+		if (etu->statut == DEMISSION) {
+			return BILAN_DEMISSION;
+		}
+		else if (etu->statut == DEFAILLANCE) {
+			return BILAN_DEFAILLANCE;
+		}
+		else if (etu->statut == EN_COURS) {
+			return BILAN_EN_COURS;
+		}
+		else if (etu->statut == AJOURNE) {
+			return BILAN_AJOURNE;
+		}
+		// CAS PARTICULIER : Les diplômés restent au dernier semestre (S6 en BUT)
+		else if (etu->statut == DIPLOME && annee == nb_annees) {
+			return BILAN_PASSE;
+		}
+	}
+	// CAS 3 : étudiant ayant dépassé cette année
+	else if (etu->semestre_actuel > sem_fin) {
+		return BILAN_PASSE;
+	}
+
+	return BILAN_AUCUNE;
+}
+
+// --- BILAN ---
+/**
+ * @brief Affiche le bilan d'une année spécifique.
+ *
+ * Comptabilise pour une année donnée (1, 2 ou 3 en BUT) :
+ * - Le nombre de démissions.
+ * - Le nombre de défaillances.
+ * - Le nombre d'étudiants en cours.
+ * - Le nombre d'ajournés.
+ * - Le nombre d'étudiants ayant réussi (passés à l'année sup ou diplômés).
+ *
+ * @param promo Pointeur vers la promotion.
+ * @param annee Année du bilan.
+ */
+void cmd_bilan(const t_promotion* promo, int annee) {
+	assert(promo != NULL);
+
+	int nb_annees = FORMATIONS[promo->num_formation].nb_annees;
+
+	if (annee < 1 || annee > nb_annees) {
+		ecrire("Annee incorrecte\n");
+		return;
+	}
+
+	int compteurs[NB_CATEGORIES_BILAN];
+
+	// Part précalculée des étudiants sortis de formation, puis étudiants actifs
+	for (int cat = 0; cat < NB_CATEGORIES_BILAN; cat++) {
+		compteurs[cat] = promo->bilan_archives[annee - 1][cat];
+	}
+
+	for (int a = 0; a < promo->nb_actifs; a++) {
+		compteurs[categorie_bilan(&promo->etudiants[promo->actifs[a]], annee, nb_annees)]++;
+	}
+
+	for (int cat = BILAN_DEMISSION; cat < NB_CATEGORIES_BILAN; cat++) {
+		ecrire("%d %s\n", compteurs[cat], LIBELLES_BILAN[cat]);
+	}
+}
+
+
+// ============================================================================
+// SPRINT 5 - DISTRIBUTION
+// ============================================================================
+
+/**
+ * @brief Fonction de comparaison de notes pour qsort (ordre croissant).
+ */
+int comparer_notes(const void* a, const void* b) {
+	float na = *(const float*)a;
+	float nb = *(const float*)b;
+	return (na > nb) - (na < nb);
+}
+
+// --- DISTRIBUTION ---
+/**
+ * @brief Affiche la distribution des notes de chaque UE pour un semestre ou une année.
+ *
+ * La période est exactement de la forme S<n> (notes du semestre n) ou
+ * B<n> (moyennes annuelles de l'année n). Pour chaque UE, affiche l'effectif,
+ * la moyenne, la médiane, l'histogramme par tranches de notes et le
+ * nombre de codes ADM/ADC/ADS/AJ/AJB (mêmes règles que CURSUS).
+ *
+ * Toutes les UE sont traitées ensemble en un seul passage sur la promotion.
+ * Les lignes de notes utiles de chaque étudiant sont choisies avant les
+ * boucles sur les UE, qui sont de taille fixe (MAX_UE) et sans branchement :
+ * les moyennes sont calculées directement depuis les notes, et les codes
+ * et tranches sont comptés par des masques de comparaison (une note
+ * inconnue compte avec un poids nul), ce qui permet de les vectoriser.
+ * Les notes sont rangées en colonnes pour la médiane dans une boucle à
+ * part ; seules les UE de la formation sont affichées.
+ *
+ * @param promo Pointeur vers la promotion.
+ * @param periode Période demandée (S<n> ou B<n>).
+ */
+void cmd_distribution(const t_promotion* promo, const char* periode) {
+	assert(promo != NULL && periode != NULL);
+
+	const t_formation* formation = &FORMATIONS[promo->num_formation];
+	char type = periode[0];
+	char* fin = NULL;
+	long num = 0;
+
+	if (periode[1] >= '0' && periode[1] <= '9') // Ni blanc ni signe avant le numéro
+		num = strtol(periode + 1, &fin, 10);
+	if (fin == NULL || *fin != '\0' || // Numéro absent ou suivi d'autres caractères
+		!((type == 'S' && num >= 1 && num <= formation->nb_semestres) ||
+		(type == 'B' && num >= 1 && num <= formation->nb_annees))) {
+		ecrire("Periode incorrecte\n");
+		return;
+	}
+
+	int est_semestre = (type == 'S');
+	int an = est_semestre ? (num - 1) / 2 : num - 1;
+	int annee = an + 1;
+	float seuil_validation = formation->seuil_validation;
+	float seuil_bloquant = formation->seuil_bloquant;
+
+	float ligne_inconnue[MAX_UE];
+	for (int ue = 0; ue < MAX_UE; ue++) {
+		ligne_inconnue[ue] = NOTE_INCONNUE;
+	}
+
+	float colonnes[MAX_UE][MAX_ETUDIANTS];
+	int effectifs[MAX_UE] = { 0 };
+	float sommes[MAX_UE] = { 0.0f };
+	int tranches[NB_TRANCHES][MAX_UE] = { { 0 } };
+	int codes[NB_CODES][MAX_UE] = { { 0 } };
+
+	for (int i = 0; i < promo->nb_inscrits; i++) {
+		const t_etudiant* etu = &promo->etudiants[i];
+
+		// Lignes de notes de l'année et de l'année suivante (inconnues si son jury n'est pas fait)
+		int jury_suiv_fait = (annee < formation->nb_annees) && jury_annee_fait(etu, annee + 1);
+		const float* sem1 = etu->notes[2 * an];
+		const float* sem2 = etu->notes[2 * an + 1];
+		const float* suiv1 = jury_suiv_fait ? etu->notes[2 * an + 2] : ligne_inconnue;
+		const float* suiv2 = jury_suiv_fait ? etu->notes[2 * an + 3] : ligne_inconnue;
+
+		// Règles de CURSUS : ADC pour un semestre dont le jury d'année est fait, AJB pour une année
+		int compensation_annee = est_semestre && jury_annee_fait(etu, annee);
+		int blocage = !est_semestre;
+
+		float moyennes[MAX_UE];
+		for (int ue = 0; ue < MAX_UE; ue++) {
+			int connues = (sem1[ue] != NOTE_INCONNUE) & (sem2[ue] != NOTE_INCONNUE);
+			moyennes[ue] = connues ? (sem1[ue] + sem2[ue]) / 2.0f : NOTE_INCONNUE;
+		}
+
+		const float* valeurs = est_semestre ? etu->notes[num - 1] : moyennes;
+
+		// Colonnes de la médiane : une note inconnue est réécrite par l'étudiant suivant
+		for (int ue = 0; ue < MAX_UE; ue++) {
+			colonnes[ue][effectifs[ue]] = valeurs[ue];
+		}
+
+		// Codes (règles de code_note et code_moyenne) et tranches par masques 0/1 :
+		// boucle sans branchement, vectorisée
+		int tranche[MAX_UE];
+		for (int ue = 0; ue < MAX_UE; ue++) {
+			float note = valeurs[ue];
+			int connue = (note != NOTE_INCONNUE);
+			int suivante = (suiv1[ue] != NOTE_INCONNUE) & (suiv2[ue] != NOTE_INCONNUE) &
+				((suiv1[ue] + suiv2[ue]) / 2.0f >= seuil_validation);
+
+			int adm = (note >= seuil_validation);
+			int adc = (1 - adm) & compensation_annee & (moyennes[ue] >= seuil_validation);
+			int ads = (1 - adm) & (1 - adc) & suivante;
+			int ajb = (1 - adm) & (1 - ads) & blocage & (note < seuil_bloquant);
+			int aj = 1 - (adm | adc | ads | ajb);
+
+			effectifs[ue] += connue;
+			sommes[ue] += connue ? note : 0.0f;
+			codes[CODE_ADM][ue] += connue & adm;
+			codes[CODE_ADC][ue] += connue & adc;
+			codes[CODE_ADS][ue] += connue & ads;
+			codes[CODE_AJ][ue] += connue & aj;
+			codes[CODE_AJB][ue] += connue & ajb;
+
+			// Bornée avant la conversion, qui reste ainsi sans branchement
+			float position = note * NB_TRANCHES / MAX_NOTE;
+			position = (position < 0.0f) ? 0.0f : position;
+			position = (position > NB_TRANCHES - 1) ? NB_TRANCHES - 1 : position;
+			tranche[ue] = connue ? (int)position : -1; // Note inconnue : dans aucune tranche
+		}
+
+		for (int t = 0; t < NB_TRANCHES; t++) {
+			for (int ue = 0; ue < MAX_UE; ue++) {
+				tranches[t][ue] += (tranche[ue] == t);
+			}
+		}
+	}
+
+	float largeur = MAX_NOTE / NB_TRANCHES;
+
+	for (int ue = 0; ue < formation->nb_ue; ue++) {
+		int n = effectifs[ue];
+
+		ecrire("UE%d - %d note(s)", ue + 1, n);
+		if (n > 0) {
+			qsort(colonnes[ue], n, sizeof(float), comparer_notes);
+			float moyenne = sommes[ue] / n;
+			float mediane = (n % 2 != 0) ? colonnes[ue][n / 2]
+				: (colonnes[ue][n / 2 - 1] + colonnes[ue][n / 2]) / 2.0f;
+			ecrire(" - moyenne %.1f - mediane %.1f\n",
+				floorf(moyenne * 10.0f) / 10.0f, floorf(mediane * 10.0f) / 10.0f);
+		}
+		else {
+			ecrire(" - moyenne * - mediane *\n");
+		}
+
+		for (int t = 0; t < NB_TRANCHES; t++) {
+			ecrire("%s[%g-%g%c %d", (t == 0) ? "" : " - ", t * largeur, (t + 1) * largeur,
+				(t == NB_TRANCHES - 1) ? ']' : '[', tranches[t][ue]);
+		}
+		ecrire("\n");
+
+		for (int c = 0; c < NB_CODES; c++) {
+			ecrire("%s%s %d", (c == 0) ? "" : " - ", LIBELLES_CODES[c], codes[c][ue]);
+		}
+		ecrire("\n");
+	}
+}
+
+// --- SIMULER_JURY ---
+/**
+ * @brief Simule un jury de semestre sans modifier la promotion.
+ *
+ * Applique les mêmes vérifications et les mêmes règles que JURY, mais sur
+ * une copie locale de chaque étudiant concerné (les autres étudiants ne
+ * sont ni copiés ni modifiés). Affiche la décision prévue pour chaque
+ * étudiant puis, pour chaque année impactée, la variation du bilan.
+ *
+ * @param promo Pointeur vers la promotion (non modifiée).
+ * @param num_sem Numéro du semestre.
+ */
+void cmd_simuler_jury(const t_promotion* promo, int num_sem) {
+	assert(promo != NULL);
+
+	const t_formation* formation = &FORMATIONS[promo->num_formation];
+
+	if (num_sem < 1 || num_sem > formation->nb_semestres) {
+		ecrire("Semestre incorrect\n");
+		return;
+	}
+
+	if (verif_notes_incompletes(promo, num_sem)) {
+		ecrire("Des notes sont manquantes\n");
+		return;
+	}
+
+	int deltas[MAX_ANNEES][NB_CATEGORIES_BILAN] = { { 0 } };
+	int nb_etu_traites = 0;
+
+	for (int a = 0; a < promo->nb_actifs; a++) {
+		int i = promo->actifs[a];
+		const t_etudiant* etu = &promo->etudiants[i];
+
+		if (etu->semestre_actuel != num_sem) {
+			continue;
+		}
+
+		// Copie de l'étudiant concerné, seule donnée modifiée par la simulation
+		t_etudiant copie = *etu;
+
+		if (num_sem % 2 != 0) {
+			copie.semestre_actuel++;
+		}
+		else {
+			formation->jury_fin_annee(&copie, num_sem / 2);
+		}
+		nb_etu_traites++;
+
+		ecrire("%d %s %s - ", i + 1, copie.prenom, copie.nom);
+		if (copie.statut == EN_COURS) {
+			ecrire("S%d\n", copie.semestre_actuel);
+		}
+		else {
+			afficher_statut(copie.statut);
+			ecrire("\n");
+		}
+
+		for (int an = 0; an < formation->nb_annees; an++) {
+			deltas[an][categorie_bilan(etu, an + 1, formation->nb_annees)]--;
+			deltas[an][categorie_bilan(&copie, an + 1, formation->nb_annees)]++;
+		}
+	}
+
+	ecrire("Simulation terminee pour %d etudiant(s)\n", nb_etu_traites);
+
+	for (int an = 0; an < formation->nb_annees; an++) {
+		int modifie = 0;
+		for (int cat = BILAN_DEMISSION; cat < NB_CATEGORIES_BILAN; cat++) {
+			modifie |= (deltas[an][cat] != 0);
+		}
+		if (!modifie) {
+			continue;
+		}
+
+		ecrire("B%d", an + 1);
+		for (int cat = BILAN_DEMISSION; cat < NB_CATEGORIES_BILAN; cat++) {
+			ecrire(" - %+d %s", deltas[an][cat], LIBELLES_BILAN[cat]);
+		}
+		ecrire("\n");
+	}
+}
+
+
+// ============================================================================
+// SPRINT 6 - HISTORIQUE
+// ============================================================================
+
+/**
+ * @brief Ajoute une modification d'un étudiant à l'historique.
+ *
+ * À appeler après la modification. Le premier événement d'un étudiant puis
+ * un événement sur INTERVALLE_POINTS déclenchent une copie complète de son
+ * état (point de reprise). Si l'historique est plein, les modifications
+ * suivantes ne sont plus enregistrées, ce qui est signalé une fois.
+ *
+ * @param promo Pointeur vers la promotion.
+ * @param idx Index de l'étudiant modifié.
+ * @param type Type de modification.
+ * @param idx_sem Index du semestre (EVT_NOTE).
+ * @param idx_ue Index de l'UE (EVT_NOTE).
+ * @param valeur Nouvelle note, nouveau semestre ou nouveau statut.
+ */
+void historique_enregistrer(t_promotion* promo, int idx, t_type_evenement type, int idx_sem, int idx_ue, float valeur) {
+	assert(promo != NULL && idx >= 0 && idx < promo->nb_inscrits);
+
+	t_historique* hist = &promo->historique;
+
+	if (hist->nb_evenements == MAX_EVENEMENTS) {
+		if (!hist->plein) {
+			ecrire("Historique plein\n");
+			hist->plein = 1;
+		}
+		return;
+	}
+
+	int num = hist->nb_evenements++;
+	t_evenement* evt = &hist->evenements[num];
+
+	evt->type = (unsigned char)type;
+	evt->idx_etu = (unsigned char)idx;
+	evt->idx_sem = (unsigned char)idx_sem;
+	evt->idx_ue = (unsigned char)idx_ue;
+	evt->valeur = valeur;
+	evt->precedent = hist->dernier_evenement[idx];
+	hist->dernier_evenement[idx] = num;
+
+	if (hist->nb_evenements_etu[idx]++ % INTERVALLE_POINTS == 0) {
+		assert(hist->nb_points < MAX_POINTS);
+
+		t_point_reprise* point = &hist->points[hist->nb_points];
+		point->etat = promo->etudiants[idx];
+		point->evenement = num;
+		point->precedent = hist->dernier_point[idx];
+		hist->dernier_point[idx] = hist->nb_points++;
+	}
+}
+
+/**
+ * @brief Termine la version en cours de l'historique.
+ *
+ * Appelée après chaque commande de modification : tous ses événements
+ * forment une seule version. Une commande refusée, sans événement, ne
+ * crée pas de version, ni une commande dont l'historique plein n'a pas pu
+ * tout enregistrer (ni les suivantes).
+ *
+ * @param promo Pointeur vers la promotion.
+ */
+void historique_valider(t_promotion* promo) {
+	assert(promo != NULL);
+
+	t_historique* hist = &promo->historique;
+
+	if (!hist->plein && hist->nb_evenements > hist->fin_versions[hist->nb_versions]) {
+		hist->fin_versions[++hist->nb_versions] = hist->nb_evenements;
+	}
+}
+
+/**
+ * @brief Reconstruit l'état d'un étudiant à une version passée.
+ *
+ * Part du dernier point de reprise de l'étudiant antérieur à la version,
+ * puis rejoue ses seuls événements suivants (au plus INTERVALLE_POINTS).
+ * Les processus de rapport l'appellent sur une promotion qui peut être en
+ * cours de modification : aucun index lu dans l'historique n'est supposé
+ * valide, et une chaîne incohérente fait renvoyer 0 (la lecture, refaite
+ * par executer_rapport, ne l'utilise pas).
+ *
+ * @param promo Pointeur vers la promotion.
+ * @param idx Index de l'étudiant.
+ * @param nb_evenements Nombre d'événements pris en compte (fin_versions de la version demandée).
+ * @param etat Pointeur vers l'étudiant reconstruit.
+ * @return 1 si l'étudiant était inscrit à cette version, 0 sinon.
+ */
+int reconstruire_etudiant(const t_promotion* promo, int idx, int nb_evenements, t_etudiant* etat) {
+	assert(promo != NULL && etat != NULL && idx >= 0 && idx < MAX_ETUDIANTS);
+
+	const t_historique* hist = &promo->historique;
+
+	// Point de reprise le plus récent antérieur à la version
+	int point = hist->dernier_point[idx];
+	int debut = hist->dernier_evenement[idx];
+
+	// Les points d'un étudiant sont chaînés par index décroissants
+	while (point >= 0 && point < MAX_POINTS && hist->points[point].evenement >= nb_evenements) {
+		int precedent = hist->points[point].precedent;
+
+		if (precedent >= point) {
+			return 0;
+		}
+		debut = hist->points[point].evenement;
+		point = precedent;
+	}
+
+	if (point < 0 || point >= MAX_POINTS) {
+		return 0;
+	}
+
+	// Événements postérieurs au point de reprise, du plus récent au plus ancien
+	// (au plus INTERVALLE_POINTS jusqu'au point suivant ou au dernier événement)
+	int a_rejouer[INTERVALLE_POINTS];
+	int nb_a_rejouer = 0;
+	int nb_parcourus = 0;
+
+	for (int e = debut; e > hist->points[point].evenement; e = hist->evenements[e].precedent) {
+		if (e < 0 || e >= MAX_EVENEMENTS || nb_parcourus++ == INTERVALLE_POINTS) {
+			return 0;
+		}
+		if (e < nb_evenements) {
+			a_rejouer[nb_a_rejouer++] = e;
+		}
+	}
+
+	*etat = hist->points[point].etat;
+
+	for (int i = nb_a_rejouer - 1; i >= 0; i--) {
+		const t_evenement* evt = &hist->evenements[a_rejouer[i]];
+
+		switch (evt->type) {
+		case EVT_NOTE:
+			if (evt->idx_sem >= MAX_SEMESTRES || evt->idx_ue >= MAX_UE) {
+				return 0;
+			}
+			etat->notes[evt->idx_sem][evt->idx_ue] = evt->valeur;
+			break;
+		case EVT_SEMESTRE: etat->semestre_actuel = (int)evt->valeur;            break;
+		case EVT_STATUT:   etat->statut = (t_statut)evt->valeur;                break;
+		default:           break;
+		}
+	}
+
+	return 1;
+}
+
+// --- VERSION ---
+/**
+ * @brief Affiche la version actuelle de la promotion (nombre de commandes l'ayant modifiée).
+ *
+ * Si l'historique est plein, c'est la dernière version enregistrée, suivie
+ * de l'indication Historique plein.
+ *
+ * @param promo Pointeur vers la promotion.
+ */
+void cmd_version(const t_promotion* promo) {
+	assert(promo != NULL);
+
+	ecrire("Version %d\n", promo->historique.nb_versions);
+
+	if (promo->historique.plein) {
+		ecrire("Historique plein\n");
+	}
+}
+
+
+// ============================================================================
+// SPRINT 7 - MODE BATCH (PIPELINE)
+// ============================================================================
+
+#ifdef MODE_BATCH
+
+/**
+ * @brief Initialise une file circulaire vide.
+ *
+ * @param anneau Pointeur vers la file.
+ */
+void anneau_init(t_anneau* anneau) {
+	assert(anneau != NULL);
+
+	atomic_init(&anneau->tete, 0);
+	atomic_init(&anneau->queue, 0);
+}
+
+/**
+ * @brief Attend un peu avant de réessayer d'accéder à une file.
+ *
+ * Cède d'abord le processeur, puis s'endort brièvement si l'attente dure,
+ * pour ne pas voler le temps de calcul de l'étage qui doit avancer.
+ *
+ * @param essais Nombre d'essais déjà faits, mis à jour.
+ */
+void anneau_patienter(int* essais) {
+	assert(essais != NULL);
+
+	if (++(*essais) < ESSAIS_AVANT_PAUSE) {
+		sched_yield();
+	}
+	else {
+		struct timespec pause = { 0, DUREE_PAUSE_NS };
+		nanosleep(&pause, NULL);
+	}
+}
+
+/**
+ * @brief Attend une case libre (producteur).
+ *
+ * @param anneau Pointeur vers la file.
+ * @param capacite Nombre de cases de la file.
+ * @return L'index de la case à remplir avant anneau_publier.
+ */
+size_t anneau_reserver(t_anneau* anneau, size_t capacite) {
+	assert(anneau != NULL);
+
+	size_t queue = atomic_load_explicit(&anneau->queue, memory_order_relaxed);
+	int essais = 0;
+
+	while (queue - atomic_load_explicit(&anneau->tete, memory_order_acquire) == capacite) {
+		anneau_patienter(&essais);
+	}
+
+	return queue % capacite;
+}
+
+/**
+ * @brief Rend la case réservée visible au consommateur.
+ *
+ * @param anneau Pointeur vers la file.
+ */
+void anneau_publier(t_anneau* anneau) {
+	assert(anneau != NULL);
+
+	atomic_fetch_add_explicit(&anneau->queue, 1, memory_order_release);
+}
+
+/**
+ * @brief Attend une case publiée (consommateur).
+ *
+ * @param anneau Pointeur vers la file.
+ * @param capacite Nombre de cases de la file.
+ * @return L'index de la case à lire avant anneau_liberer.
+ */
+size_t anneau_attendre(t_anneau* anneau, size_t capacite) {
+	assert(anneau != NULL);
+
+	size_t tete = atomic_load_explicit(&anneau->tete, memory_order_relaxed);
+	int essais = 0;
+
+	while (atomic_load_explicit(&anneau->queue, memory_order_acquire) == tete) {
+		anneau_patienter(&essais);
+	}
+
+	return tete % capacite;
+}
+
+/**
+ * @brief Rend la case lue au producteur.
+ *
+ * @param anneau Pointeur vers la file.
+ */
+void anneau_liberer(t_anneau* anneau) {
+	assert(anneau != NULL);
+
+	atomic_fetch_add_explicit(&anneau->tete, 1, memory_order_release);
+}
+
+/**
+ * @brief Thread de lecture : décode les commandes et les transmet à l'exécution.
+ *
+ * S'arrête après avoir transmis EXIT (ou la fin de l'entrée).
+ *
+ * @param arg Pointeur vers le pipeline.
+ * @return NULL.
+ */
+void* thread_lecture(void* arg) {
+	t_pipeline* pipeline = arg;
+	int fin = 0;
+
+	while (!fin) {
+		size_t idx = anneau_reserver(&pipeline->anneau_commandes, CAPACITE_COMMANDES);
+		t_commande* cmd = &pipeline->commandes[idx];
+
+		lire_commande(&pipeline->lecteur, cmd);
+		fin = (cmd->type == CMD_EXIT);
+
+		anneau_publier(&pipeline->anneau_commandes);
+	}
+
+	return NULL;
+}
+
+/**
+ * @brief Thread d'écriture : écrit les blocs de sortie sur stdout dans l'ordre.
+ *
+ * S'arrête après le bloc marqué comme dernier.
+ *
+ * @param arg Pointeur vers le pipeline.
+ * @return NULL.
+ */
+void* thread_ecriture(void* arg) {
+	t_pipeline* pipeline = arg;
+	int fin = 0;
+
+	while (!fin) {
+		size_t idx = anneau_attendre(&pipeline->anneau_blocs, CAPACITE_BLOCS);
+		const t_bloc_sortie* bloc = &pipeline->blocs[idx];
+
+		fwrite(bloc->texte, 1, bloc->taille, stdout);
+		fin = bloc->fin;
+
+		anneau_liberer(&pipeline->anneau_blocs);
+	}
+
+	fflush(stdout);
+	return NULL;
+}
 
-				afficher_note_avec_code(etu->notes[sem_impair - 1][ue], moy_compens, moy_suiv);
-			}
-			printf(" -");
-			if (etu->semestre_actuel == sem_impair) {
-				printf(" ");
-				afficher_statut(etu->statut);
-			}
-			printf("\n");
-		}
+/**
+ * @brief Transmet le bloc courant au thread d'écriture.
+ *
+ * Réserve un bloc vide si aucun n'est en cours (nécessaire pour le dernier bloc).
+ *
+ * @param pipeline Pointeur vers le pipeline.
+ * @param fin 1 s'il s'agit du dernier bloc.
+ */
+void pipeline_publier_bloc(t_pipeline* pipeline, int fin) {
+	assert(pipeline != NULL);
 
-		// Semestre pair (S2, S4, S6...)
-		if (etu->semestre_actuel >= sem_pair) {
-			printf("S%d", sem_pair);
-			for (int ue = 0; ue < NB_UE; ue++) {
-				printf(" - ");
-				float moy_compens = jury_fait[an] ? moyennes_annee[an][ue] : NOTE_INCONNUE;
-				float moy_suiv = (an < NB_ANNEES - 1 && jury_fait[an + 1]) ? moyennes_annee[an + 1][ue] : NOTE_INCONNUE;
+	if (pipeline->bloc_courant == NULL) {
+		pipeline->bloc_courant = &pipeline->blocs[anneau_reserver(&pipeline->anneau_blocs, CAPACITE_BLOCS)];
+		pipeline->bloc_courant->taille = 0;
+	}
 
-				// Pour S6, pas de compensation année suivante
-				if (annee == NB_ANNEES) moy_suiv = NOTE_INCONNUE;
+	pipeline->bloc_courant->fin = fin;
+	pipeline->bloc_courant = NULL;
+	anneau_publier(&pipeline->anneau_blocs);
+}
 
-				afficher_note_avec_code(etu->notes[sem_pair - 1][ue], moy_compens, moy_suiv);
-			}
-			printf(" -");
-			if (etu->semestre_actuel == sem_pair && etu->statut != AJOURNE && etu->statut != DIPLOME) {
-				printf(" ");
-				afficher_statut(etu->statut);
-			}
-			printf("\n");
+/**
+ * @brief Formate un texte dans le bloc de sortie courant.
+ *
+ * Si le texte ne tient pas dans la place restante, le bloc est transmis
+ * au thread d'écriture et le texte est formaté dans un nouveau bloc.
+ *
+ * @param pipeline Pointeur vers le pipeline.
+ * @param format Format (comme printf).
+ * @param args Arguments du format.
+ */
+void pipeline_ecrire(t_pipeline* pipeline, const char* format, va_list args) {
+	assert(pipeline != NULL && format != NULL);
+
+	for (int essai = 0; essai < 2; essai++) {
+		if (pipeline->bloc_courant == NULL) {
+			pipeline->bloc_courant = &pipeline->blocs[anneau_reserver(&pipeline->anneau_blocs, CAPACITE_BLOCS)];
+			pipeline->bloc_courant->taille = 0;
 		}
 
-		// Bilan Annuel (B1, B2, B3...)
-		if (jury_fait[an] || (etu->semestre_actuel == sem_pair && etu->statut == AJOURNE)) {
-			printf("B%d", annee);
-			for (int ue = 0; ue < NB_UE; ue++) {
-				printf(" - ");
-				float moy_suiv = (an < NB_ANNEES - 1 && jury_fait[an + 1]) ? moyennes_annee[an + 1][ue] : NOTE_INCONNUE;
-				
-				// Pour B3, pas de compensation suivante
-				if (annee == NB_ANNEES) moy_suiv = NOTE_INCONNUE;
+		t_bloc_sortie* bloc = pipeline->bloc_courant;
+		size_t reste = TAILLE_BLOC - bloc->taille;
 
-				afficher_moyenne_avec_code(moyennes_annee[an][ue], moy_suiv);
-			}
-			printf(" -");
-			if (etu->semestre_actuel == sem_pair && etu->statut == AJOURNE) {
-				printf(" ajourne");
-			} else if (annee == NB_ANNEES && etu->statut == DIPLOME) {
-				printf(" ");
-				afficher_statut(etu->statut);
-			}
-			printf("\n");
+		va_list copie;
+		va_copy(copie, args);
+		int lg = vsnprintf(bloc->texte + bloc->taille, reste, format, copie);
+		va_end(copie);
+
+		if (lg >= 0 && (size_t)lg < reste) {
+			bloc->taille += lg;
+			return;
 		}
+
+		pipeline_publier_bloc(pipeline, 0);
 	}
+
+	assert(0 && "texte plus long qu'un bloc de sortie");
 }
+#endif
 
-// --- ETUDIANTS ---
 /**
- * @brief Affiche la liste de tous les étudiants de la promotion.
+ * @brief Exécute les commandes en mode batch.
  *
- * Affiche l'ID, le nom, le prénom, le semestre actuel et le statut.
+ * La lecture et l'écriture ont chacune leur thread, reliés au thread
+ * appelant (exécution) par deux files sans verrou. Les commandes sont
+ * exécutées une par une dans l'ordre de lecture, et la sortie est
+ * identique à celle du mode interactif.
  *
  * @param promo Pointeur vers la promotion.
+ * @param entree Flux des commandes.
+ * @return 1 si les commandes ont été exécutées, 0 si les threads n'ont pas
+ *         pu être lancés ou ne sont pas disponibles (exécution séquentielle).
  */
-void cmd_etudiants(const t_promotion* promo) {
-	assert(promo != NULL);
+int executer_pipeline(t_promotion* promo, FILE* entree) {
+	assert(promo != NULL && entree != NULL);
+
+#ifdef MODE_BATCH
+	static t_pipeline pipeline;
+	pthread_t lecture, ecriture;
+
+	pipeline.lecteur.entree = entree;
+	pipeline.lecteur.ligne = 1;
+	pipeline.lecteur.notes_restantes = 0;
+	pipeline.lecteur.nb_ue = FORMATIONS[promo->num_formation].nb_ue;
+	pipeline.bloc_courant = NULL;
+	anneau_init(&pipeline.anneau_commandes);
+	anneau_init(&pipeline.anneau_blocs);
+
+	if (pthread_create(&ecriture, NULL, thread_ecriture, &pipeline) != 0) {
+		return 0;
+	}
+	if (pthread_create(&lecture, NULL, thread_lecture, &pipeline) != 0) {
+		pipeline_publier_bloc(&pipeline, 1);
+		pthread_join(ecriture, NULL);
+		return 0;
+	}
 
-	for (int i = 0; i < promo->nb_inscrits; i++) {
-		const t_etudiant* etu = &promo->etudiants[i];
-		int id = i + 1;
+	pipeline_sortie = &pipeline;
 
-		printf("%d - %s %s - S%d - ", id, etu->prenom, etu->nom, etu->semestre_actuel);
-		afficher_statut(etu->statut);
-		printf("\n");
+	int continuer = 1;
+	while (continuer) {
+		size_t idx = anneau_attendre(&pipeline.anneau_commandes, CAPACITE_COMMANDES);
+
+		continuer = executer_commande(promo, &pipeline.commandes[idx]);
+
+		anneau_liberer(&pipeline.anneau_commandes);
 	}
+
+	pipeline_publier_bloc(&pipeline, 1);
+	pipeline_sortie = NULL;
+
+	pthread_join(lecture, NULL);
+	pthread_join(ecriture, NULL);
+	return 1;
+#else
+	(void)promo;
+	(void)entree;
+	return 0;
+#endif
 }
 
+
 // ============================================================================
-// SPRINT 2 - DEMISSION, DEFAILLANCE, JURY (semestres impairs)
+// SPRINT 8 - PUBLICATION EN MEMOIRE PARTAGEE
 // ============================================================================
 
-// --- DEMISSION / DEFAILLANCE ---
 /**
- * @brief Change le statut d'un étudiant (Démission ou Défaillance).
+ * @brief Crée et initialise la promotion, publiée en mémoire partagée si demandé.
  *
- * Vérifie l'ID et si l'étudiant est EN_COURS.
- * Modifie le statut selon le paramètre nouveau_statut.
+ * Sans nom de segment, la promotion est locale au processus. Sinon, crée
+ * le segment nom_segment (voir t_segment_promotion), lisible par le
+ * seul propriétaire, qui ne doit pas déjà exister : un segment n'est
+ * jamais partagé par deux processus principaux. Un segment abandonné par
+ * un processus principal arrêté sans EXIT est remplacé. Si la mémoire
+ * partagée n'est pas disponible, la promotion est locale au processus.
  *
- * @param promo Pointeur vers la promotion.
- * @param nouveau_statut Nouveau statut à appliquer (DEMISSION ou DEFAILLANCE).
+ * @param num_formation Formation suivie par la promotion.
+ * @param nom_segment Nom du segment à créer (NULL : promotion non publiée).
+ * @return Pointeur vers la promotion initialisée, NULL si le segment existe déjà.
  */
-void cmd_changer_statut(t_promotion* promo, t_statut nouveau_statut) {
-	assert(promo != NULL);
+t_promotion* publier_promotion(int num_formation, const char* nom_segment) {
+	static t_promotion promo_locale; // Trop volumineuse (historique) pour la pile
 
-	int id_etu;
-	scanf("%d", &id_etu);
-
-	if (id_etu <= 0 || id_etu > promo->nb_inscrits) {
-		printf("Identifiant incorrect\n");
-		return;
+	if (nom_segment == NULL) {
+		init_promotion(&promo_locale, num_formation);
+		return &promo_locale;
 	}
 
-	int idx = id_etu - 1;
+#ifdef PROMOTION_PARTAGEE
+	int fd = shm_open(nom_segment, O_CREAT | O_EXCL | O_RDWR, 0600);
 
-	if (promo->etudiants[idx].statut != EN_COURS) {
-		printf("Etudiant hors formation\n");
-		return;
+	if (fd == -1 && errno == EEXIST && segment_abandonne(nom_segment)) {
+		shm_unlink(nom_segment); // Laissé par un processus principal arrêté sans EXIT
+		fd = shm_open(nom_segment, O_CREAT | O_EXCL | O_RDWR, 0600);
+	}
+	if (fd == -1 && errno == EEXIST) {
+		return NULL;
 	}
 
-	promo->etudiants[idx].statut = nouveau_statut;
+	if (fd != -1) {
+		void* adresse = MAP_FAILED;
 
-	if (nouveau_statut == DEMISSION) {
-		printf("Demission enregistree\n");
-	}
-	else {
-		printf("Defaillance enregistree\n");
+		if (ftruncate(fd, sizeof(t_segment_promotion)) == 0) {
+			adresse = mmap(NULL, sizeof(t_segment_promotion), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+		}
+		close(fd);
+
+		if (adresse != MAP_FAILED) {
+			t_segment_promotion* segment = adresse;
+
+			segment->magique = 0;
+			init_promotion(&segment->promo, num_formation);
+			segment->taille = sizeof(t_segment_promotion);
+			segment->pid = (long)getpid();
+			atomic_thread_fence(memory_order_release);
+			segment->magique = MAGIQUE_SEGMENT;
+
+			segment_publie = segment;
+			nom_segment_publie = nom_segment;
+			return &segment->promo;
+		}
+		shm_unlink(nom_segment);
 	}
-}
+#endif
 
-// --- Fonctions auxiliaires pour JURY ---
+	init_promotion(&promo_locale, num_formation);
+	return &promo_locale;
+}
 
 /**
- * @brief Vérifie si toutes les notes sont saisies pour un semestre donné.
+ * @brief Retire la promotion de la mémoire partagée en fin de programme.
  *
- * Pour les jurys pairs (fin d'année), on vérifie le semestre pair courant.
- * (Il est impossible d'être en semestre pair sans avoir validé le précédent).
- * Pour les jurys impairs, vérifie uniquement le semestre courant.
+ * Les processus de rapport qui l'ont déjà projetée peuvent continuer à la lire.
+ * Une promotion locale au processus n'a rien à retirer.
  *
- * @param promo Pointeur vers la promotion.
- * @param num_sem Numéro du semestre à vérifier.
- * @return 1 si des notes sont manquantes, 0 sinon.
+ * @param promo Pointeur vers la promotion renvoyée par publier_promotion.
  */
-int verif_notes_incompletes(const t_promotion* promo, int num_sem) {
+void retirer_promotion(t_promotion* promo) {
 	assert(promo != NULL);
 
-	int idx_sem = num_sem - 1;
-
-	for (int i = 0; i < promo->nb_inscrits; i++) {
-		if (promo->etudiants[i].statut != EN_COURS ||
-			promo->etudiants[i].semestre_actuel != num_sem) {
-			continue;
-		}
-
-		for (int ue = 0; ue < NB_UE; ue++) {
-			if (promo->etudiants[i].notes[idx_sem][ue] == NOTE_INCONNUE) {
-				return 1;
-			}
-		}
+#ifdef PROMOTION_PARTAGEE
+	if (segment_publie != NULL && promo == &segment_publie->promo) {
+		munmap(segment_publie, sizeof(t_segment_promotion));
+		shm_unlink(nom_segment_publie);
+		segment_publie = NULL;
 	}
-
-	return 0;
+#else
+	(void)promo; // Jamais publiée sans mémoire partagée
+#endif
 }
 
 /**
- * @brief Fait passer les étudiants au semestre suivant (pour les jurys impairs).
+ * @brief Signale le début d'une modification aux lecteurs (génération impaire).
  *
  * @param promo Pointeur vers la promotion.
- * @param num_sem Numéro du semestre actuel.
- * @return Le nombre d'étudiants ayant changé de semestre.
  */
-int passer_semestre_suivant(t_promotion* promo, int num_sem) {
+void debut_modification(t_promotion* promo) {
 	assert(promo != NULL);
 
-	// Vérifie que le semestre est bien impair
-	if (num_sem % 2 == 0) {
-		return 0;
-	}
+#ifdef PROMOTION_PARTAGEE
+	atomic_fetch_add_explicit(&promo->generation, 1, memory_order_relaxed);
+	atomic_thread_fence(memory_order_release);
+#else
+	promo->generation++;
+#endif
+}
 
-	int compteur = 0;
-	for (int i = 0; i < promo->nb_inscrits; i++) {
-		if (promo->etudiants[i].statut == EN_COURS &&
-			promo->etudiants[i].semestre_actuel == num_sem) {
+/**
+ * @brief Signale la fin d'une modification aux lecteurs (génération paire).
+ *
+ * @param promo Pointeur vers la promotion.
+ */
+void fin_modification(t_promotion* promo) {
+	assert(promo != NULL);
 
-			promo->etudiants[i].semestre_actuel++;
-			compteur++;
-		}
-	}
-	return compteur;
+#ifdef PROMOTION_PARTAGEE
+	atomic_fetch_add_explicit(&promo->generation, 1, memory_order_release);
+#else
+	promo->generation++;
+#endif
 }
 
-// --- JURY ---
 /**
- * @brief Gère les jurys de fin de semestre.
+ * @brief Répond aux requêtes à partir de la promotion publiée par un autre processus.
  *
- * Vérifie que toutes les notes sont présentes.
- * Si semestre impair : passage automatique au suivant.
- * Si semestre pair : appel de la fonction générique jury_fin_annee.
+ * Projette le segment nom_segment en lecture seule et exécute les requêtes
+ * (CURSUS, ETUDIANTS, BILAN, DISTRIBUTION, SIMULER_JURY, VERSION) directement
+ * sur la promotion partagée, sans la copier. La sortie d'une requête est
+ * préparée dans un tampon, puis écrite seulement si aucune modification n'a
+ * eu lieu pendant son exécution ; sinon la requête est refaite. Le segment
+ * d'un processus principal qui n'existe plus (arrêté sans EXIT) est refusé.
  *
- * @param promo Pointeur vers la promotion.
+ * @param entree Flux des commandes.
+ * @param nom_segment Nom du segment publié par le processus principal.
+ * @return 0 en cas de succès, 1 si aucune promotion n'est publiée.
  */
-void cmd_jury(t_promotion* promo) {
-	assert(promo != NULL);
+int executer_rapport(FILE* entree, const char* nom_segment) {
+	assert(entree != NULL && nom_segment != NULL);
 
-	int num_sem;
-	scanf("%d", &num_sem);
+#ifdef PROMOTION_PARTAGEE
+	const t_segment_promotion* segment = MAP_FAILED;
+	int fd = shm_open(nom_segment, O_RDONLY, 0);
 
-	if (num_sem < 1 || num_sem > NB_SEMESTRES) {
-		printf("Semestre incorrect\n");
-		return;
+	if (fd != -1) {
+		struct stat infos;
+
+		if (fstat(fd, &infos) == 0 && (size_t)infos.st_size == sizeof(t_segment_promotion)) {
+			segment = mmap(NULL, sizeof(t_segment_promotion), PROT_READ, MAP_SHARED, fd, 0);
+		}
+		close(fd);
 	}
 
-	if (verif_notes_incompletes(promo, num_sem)) {
-		printf("Des notes sont manquantes\n");
-		return;
+	if (segment == MAP_FAILED || segment->magique != MAGIQUE_SEGMENT ||
+		segment->taille != sizeof(t_segment_promotion) ||
+		segment->promo.num_formation < 0 || segment->promo.num_formation >= NB_FORMATIONS ||
+		(kill((pid_t)segment->pid, 0) == -1 && errno == ESRCH)) {
+		fprintf(stderr, "Aucune promotion publiee\n");
+		return 1;
 	}
 
-	int nb_etu_traites = 0;
+	atomic_thread_fence(memory_order_acquire);
 
-	if (num_sem % 2 != 0) {
-		// SEMESTRES IMPAIRS : Passage automatique
-		nb_etu_traites = passer_semestre_suivant(promo, num_sem);
-	}
-	else {
-		// SEMESTRES PAIRS : Application des règles
-		for (int i = 0; i < promo->nb_inscrits; i++) {
-			if (promo->etudiants[i].statut == EN_COURS &&
-				promo->etudiants[i].semestre_actuel == num_sem) {
+	const t_promotion* promo = &segment->promo;
+	static t_bloc_sortie tampon;
+	t_commande cmd;
+	t_lecteur lecteur = { entree, 1, 0, FORMATIONS[promo->num_formation].nb_ue };
 
-				nb_etu_traites++;
-				jury_fin_annee(&promo->etudiants[i], num_sem / 2);
+	for (lire_commande(&lecteur, &cmd); cmd.type != CMD_EXIT; lire_commande(&lecteur, &cmd)) {
+		unsigned int avant, apres;
+		int requete;
+
+		do {
+			// Attendre la fin d'une éventuelle modification en cours
+			while ((avant = atomic_load_explicit(&promo->generation, memory_order_acquire)) % 2 != 0) {
+				sched_yield();
+			}
+
+			tampon.taille = 0;
+			capture_sortie = &tampon;
+			requete = executer_requete(promo, &cmd);
+			capture_sortie = NULL;
+
+			atomic_thread_fence(memory_order_acquire);
+			apres = atomic_load_explicit(&promo->generation, memory_order_relaxed);
+
+			if (avant != apres) {
+				vider_cache_cursus(); // Des cursus ont pu être rendus pendant une modification
 			}
+		} while (avant != apres);
+
+		if (requete) {
+			fwrite(tampon.texte, 1, tampon.taille, stdout);
+		}
+		else if (cmd.type != CMD_INCONNUE) {
+			printf("Commande en lecture seule\n");
 		}
 	}
 
-	printf("Semestre termine pour %d etudiant(s)\n", nb_etu_traites);
+	munmap((void*)segment, sizeof(t_segment_promotion));
+	return 0;
+#else
+	(void)entree;
+	(void)nom_segment;
+	fprintf(stderr, "Aucune promotion publiee\n");
+	return 1;
+#endif
 }
 
-// ============================================================================
-// SPRINT 3 - JURY (semestres pairs)
-// ============================================================================
-
 /**
- * @brief Applique les règles de validation d'une année.
- *
- * Cette fonction générique gère tous les jurys de fin d'année (1, 2, 3...).
+ * @brief Indique si un segment existant a été laissé par un processus principal disparu.
  *
- * Règles générales :
- * 1. Pour l'année courante :
- *    - Années intermédiaires : Avoir validé au moins MIN_RCUE_VALIDES UE et aucun blocage.
- *    - Année finale : Avoir validé TOUTES_UE_VALIDEES UE.
- * 2. Pour les années précédentes (si annee > 1) :
- *    - Avoir validé toutes les UE de l'année précédente (via compensation si nécessaire).
+ * Seul un segment valide dont le processus principal n'existe plus est
+ * considéré comme abandonné : un segment en cours d'initialisation ou
+ * d'un autre programme n'est jamais remplacé.
  *
- * @param etu Pointeur vers l'étudiant.
- * @param annee Année à valider (1, 2, 3...).
+ * @param nom_segment Nom du segment.
+ * @return 1 si le segment peut être supprimé, 0 sinon.
  */
-void jury_fin_annee(t_etudiant* etu, int annee) {
-	assert(etu != NULL && annee >= 1 && annee <= NB_ANNEES);
+int segment_abandonne(const char* nom_segment) {
+	assert(nom_segment != NULL);
 
-	float moy_annee[NB_UE];
-	float moy_prec[NB_UE]; // Pour stocker les moyennes de l'année précédente si besoin
+	int abandonne = 0;
 
-	int nb_valides = 0;
-	int a_rcue_bloquant = 0;
-	int annees_prec_ok = 1;
+#ifdef PROMOTION_PARTAGEE
+	int fd = shm_open(nom_segment, O_RDONLY, 0);
 
-	// Vérification de l'année précédente (si elle existe)
-	if (annee > 1) {
-		for (int ue = 0; ue < NB_UE; ue++) {
-			moy_prec[ue] = calculer_moyenne_annee(etu, annee - 1, ue);
-			moy_annee[ue] = calculer_moyenne_annee(etu, annee, ue); // On en a besoin pour vérifier la compensation
+	if (fd != -1) {
+		struct stat infos;
 
-			// L'UE de l'année précédente est validée si :
-			// - Sa moyenne est >= SEUIL_VALIDATION
-			// - OU si elle est compensée par l'UE correspondante de l'année courante (moy_annee >= SEUIL_VALIDATION)
-			// Note: Dans le code original jury_fin_annee2/3, la condition était :
-			// if (moy_b1[ue] < 10 && moy_b2[ue] < 10) alors KO.
-			// Ce qui revient à dire : OK si moy_b1 >= 10 OU moy_b2 >= 10.
-			if (moy_prec[ue] < SEUIL_VALIDATION && moy_annee[ue] < SEUIL_VALIDATION) {
-				annees_prec_ok = 0;
+		if (fstat(fd, &infos) == 0 && (size_t)infos.st_size == sizeof(t_segment_promotion)) {
+			const t_segment_promotion* segment = mmap(NULL, sizeof(t_segment_promotion), PROT_READ, MAP_SHARED, fd, 0);
+
+			if (segment != MAP_FAILED) {
+				abandonne = segment->magique == MAGIQUE_SEGMENT && segment->taille == sizeof(t_segment_promotion) &&
+					kill((pid_t)segment->pid, 0) == -1 && errno == ESRCH;
+				munmap((void*)segment, sizeof(t_segment_promotion));
 			}
 		}
+		close(fd);
 	}
-	else {
-		// Pour la première année, il suffit de calculer ses moyennes
-		for (int ue = 0; ue < NB_UE; ue++) {
-			moy_annee[ue] = calculer_moyenne_annee(etu, annee, ue);
-		}
-	}
+#else
+	(void)nom_segment;
+#endif
 
-	// Analyse de l'année courante
-	for (int ue = 0; ue < NB_UE; ue++) {
-		if (moy_annee[ue] >= SEUIL_VALIDATION) {
-			nb_valides++;
-		}
-		if (moy_annee[ue] < SEUIL_BLOQUANT) {
-			a_rcue_bloquant = 1;
-		}
-	}
+	return abandonne;
+}
 
-	// Application de la décision
-	int admis = 0;
 
-	if (annee < NB_ANNEES) {
-		// Année intermédiaire : Passage si conditions respectées
-		if (nb_valides >= MIN_RCUE_VALIDES && a_rcue_bloquant == 0 && annees_prec_ok) {
-			admis = 1;
-		}
-	}
-	else {
-		// Année finale (Diplôme) : Toutes les UE doivent être validées
-		if (nb_valides == TOUTES_UE_VALIDEES && annees_prec_ok) {
-			admis = 1;
-		}
-	}
+// ============================================================================
+// SPRINT 9 - FORMATIONS
+// ============================================================================
 
-	if (admis) {
-		if (annee < NB_ANNEES) {
-			etu->semestre_actuel++; // Passage au S3, S5...
-		}
-		else {
-			etu->statut = DIPLOME;
-		}
-	}
-	else {
-		etu->statut = AJOURNE;
+/**
+ * @brief Définit les fonctions spécialisées d'une formation (une ligne de LISTE_FORMATIONS).
+ *
+ * Chaque fonction développe le corps générique correspondant avec les
+ * constantes de la formation : les boucles sur les UE et les années ont une
+ * taille connue à la compilation et peuvent être déroulées.
+ */
+#define DEFINIR_FORMATION(nom, annees, ue, min_rcue, validation, bloquant) \
+	_Static_assert((annees) >= 1 && (annees) <= MAX_ANNEES && (ue) >= 1 && (ue) <= MAX_UE && (min_rcue) <= (ue), \
+		"Dimensions de la formation " #nom " hors limites"); \
+	static void jury_fin_annee_##nom(t_etudiant* etu, int annee) { \
+		jury_fin_annee(etu, annee, annees, ue, min_rcue, validation, bloquant); \
+	} \
+	static void afficher_cursus_##nom(int id_etu, const t_etudiant* etu) { \
+		afficher_cursus(id_etu, etu, annees, ue, validation, bloquant); \
+	} \
+	static int semestre_complet_##nom(const t_etudiant* etu, int idx_sem) { \
+		return semestre_complet(etu, idx_sem, ue); \
 	}
-}
+LISTE_FORMATIONS(DEFINIR_FORMATION)
+#undef DEFINIR_FORMATION
+
+/**
+ * @brief Description d'une formation dans la table FORMATIONS.
+ */
+#define DECRIRE_FORMATION(nom, annees, ue, min_rcue, validation, bloquant) \
+	{ #nom, annees, 2 * (annees), ue, min_rcue, validation, bloquant, \
+	  jury_fin_annee_##nom, afficher_cursus_##nom, semestre_complet_##nom },
+const t_formation FORMATIONS[NB_FORMATIONS] = { LISTE_FORMATIONS(DECRIRE_FORMATION) };
+#undef DECRIRE_FORMATION
+
 
 // ============================================================================
-// SPRINT 4 - BILAN
+// SPRINT 10 - CACHE DES CURSUS
 // ============================================================================
 
-// --- BILAN ---
 /**
- * @brief Affiche le bilan d'une année spécifique.
+ * @brief Signale qu'un étudiant a changé : son CURSUS sera rendu à nouveau.
  *
- * Comptabilise pour une année donnée (1, 2 ou 3) :
- * - Le nombre de démissions.
- * - Le nombre de défaillances.
- * - Le nombre d'étudiants en cours.
- * - Le nombre d'ajournés.
- * - Le nombre d'étudiants ayant réussi (passés à l'année sup ou diplômés).
+ * À appeler après toute modification des notes, du semestre ou du statut
+ * d'un étudiant.
  *
  * @param promo Pointeur vers la promotion.
+ * @param idx Index de l'étudiant modifié.
  */
-void cmd_bilan(const t_promotion* promo) {
-	assert(promo != NULL);
+void marquer_cursus_modifie(t_promotion* promo, int idx) {
+	assert(promo != NULL && idx >= 0 && idx < MAX_ETUDIANTS);
 
-	int annee;
-	scanf("%d", &annee);
+	promo->revisions[idx]++;
+}
 
-	if (annee < 1 || annee > NB_ANNEES) {
-		printf("Annee incorrecte\n");
-		return;
+/**
+ * @brief Affiche le CURSUS actuel d'un étudiant.
+ *
+ * Le texte est rendu une fois par afficher_cursus puis conservé dans
+ * cache_cursus avec la révision de l'étudiant : tant que celle-ci ne
+ * change pas, l'affichage se réduit à l'écriture du texte conservé.
+ *
+ * @param promo Pointeur vers la promotion.
+ * @param idx Index de l'étudiant (inscrit).
+ */
+void afficher_cursus_cache(const t_promotion* promo, int idx) {
+	assert(promo != NULL && idx >= 0 && idx < promo->nb_inscrits);
+
+	t_rendu_cursus* rendu = &cache_cursus[idx];
+	unsigned int revision = promo->revisions[idx];
+
+	if (!rendu->valide || rendu->revision != revision) {
+		static t_bloc_sortie brouillon;
+		t_bloc_sortie* capture_precedente = capture_sortie;
+
+		brouillon.taille = 0;
+		capture_sortie = &brouillon;
+		FORMATIONS[promo->num_formation].afficher_cursus(idx + 1, &promo->etudiants[idx]);
+		capture_sortie = capture_precedente;
+
+		assert(brouillon.taille <= TAILLE_RENDU_CURSUS);
+		memcpy(rendu->texte, brouillon.texte, brouillon.taille);
+		rendu->taille = brouillon.taille;
+		rendu->revision = revision;
+		rendu->valide = 1;
 	}
 
-	int nb_dem = 0;
-	int nb_def = 0;
-	int nb_cours = 0;
-	int nb_aj = 0;
-	int nb_reussi = 0;
-
-	int sem_debut = (annee - 1) * 2 + 1;
-	int sem_fin = annee * 2;
-
-	for (int i = 0; i < promo->nb_inscrits; i++) {
-		const t_etudiant* etu = &promo->etudiants[i];
-
-		// Ignorer les étudiants qui n'ont pas atteint cette année
-		if (etu->semestre_actuel < sem_debut) {
-			continue;
-		}
+	ecrire("%.*s", (int)rendu->taille, rendu->texte);
+}
 
-		// CAS 1 : étudiant au semestre impair de l'année
-		if (etu->semestre_actuel == sem_debut) {
-			if (etu->statut == DEMISSION) {
-				nb_dem++;
-			}
-			else if (etu->statut == DEFAILLANCE) {
-				nb_def++;
-			}
-			else if (etu->statut == EN_COURS) {
-				nb_cours++;
-			}
-		}
-		// CAS 2 : étudiant au semestre pair de l'année
-		else if (etu->semestre_actuel == sem_fin) {
-			if (etu->statut == DEMISSION) {
-				nb_dem++;
-			}
-			else if (etu->statut == DEFAILLANCE) {
-				nb_def++;
-			}
-			else if (etu->statut == EN_COURS) {
-				nb_cours++;
-			}
-			else if (etu->statut == AJOURNE) {
-				nb_aj++;
-			}
-			// CAS PARTICULIER : Les diplômés restent en S6
-			else if (etu->statut == DIPLOME && annee == NB_ANNEES) {
-				nb_reussi++;
-			}
-		}
-		// CAS 3 : étudiant ayant dépassé cette année
-		else if (etu->semestre_actuel > sem_fin) {
-			nb_reussi++;
-		}
+/**
+ * @brief Oublie tous les CURSUS rendus.
+ *
+ * Utilisé par les processus de rapport quand une lecture a croisé une
+ * modification : les textes rendus pendant celle-ci peuvent être incohérents.
+ */
+void vider_cache_cursus(void) {
+	for (int i = 0; i < MAX_ETUDIANTS; i++) {
+		cache_cursus[i].valide = 0;
 	}
-
-	printf("%d demission(s)\n", nb_dem);
-	printf("%d defaillance(s)\n", nb_def);
-	printf("%d en cours\n", nb_cours);
-	printf("%d ajourne(s)\n", nb_aj);
-	printf("%d passe(s)\n", nb_reussi);
 }
 
 